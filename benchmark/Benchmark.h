@@ -0,0 +1,74 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef BENCHMARK_BENCHMARK_H_
+#define BENCHMARK_BENCHMARK_H_
+
+#include <stdio.h>
+#include <time.h>
+
+// Minimal timing helper for standalone benchmarks. They don't need any framework.
+class Benchmark {
+public:
+    // Calls 'func' until MIN_DURATION passes and returns nanoseconds per call
+    template <typename F>
+    static double measure(F func)
+    {
+        long long iterations = 0;
+        long long start = now();
+        long long elapsed = 0;
+        do {
+            for (int i = 0; i < BATCH; ++i) {
+                func();
+            }
+            iterations += BATCH;
+            elapsed = now() - start;
+        } while (elapsed < MIN_DURATION);
+        return (double) elapsed / iterations;
+    }
+
+    // Keeps the result alive. Otherwise compiler can remove measured code
+    template <typename T>
+    static void use(const T& value)
+    {
+        asm volatile("" : : "g"(&value) : "memory");
+    }
+
+    static void printHeader(const char* name, const char* param)
+    {
+        printf("\n%s\n", name);
+        printf("%12s %16s %16s %10s\n", param, "before(ns/op)", "after(ns/op)", "speedup");
+    }
+
+    static void printRow(long long param, double before, double after)
+    {
+        printf("%12lld %16.1f %16.1f %9.1fx\n", param, before, after, after > 0 ? before / after : 0.0);
+    }
+
+private:
+    static const int BATCH = 64;
+    static const long long MIN_DURATION = 200 * 1000 * 1000LL; // 200ms
+
+    static long long now()
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+    }
+};
+
+#endif /* BENCHMARK_BENCHMARK_H_ */
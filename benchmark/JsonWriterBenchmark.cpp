@@ -0,0 +1,157 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+
+// Serialization cost of fixed-shape payloads.
+// Each payload is written with the field list which SAM uses (RunningApp, LunaTask and ApplicationManager).
+// 'before' runs the field list with JValueWriter (JValue put() and stringify()).
+// 'after' runs the same field list with JsonWriter into a reused buffer. It is what posts do now.
+// Objects are created without luna-service. So RunningApp stays in STOP status.
+
+#include <memory>
+#include <string>
+
+#include <pbnjson.hpp>
+
+#include "Benchmark.h"
+#include "base/AppDescription.h"
+#include "base/LaunchPoint.h"
+#include "base/LunaTask.h"
+#include "base/RunningApp.h"
+#include "bus/service/ApplicationManager.h"
+#include "util/JsonWriter.h"
+#include "util/JValueWriter.h"
+
+using namespace pbnjson;
+using namespace std;
+
+struct Context {
+    RunningAppPtr m_runningApp;
+    LunaTaskPtr m_lunaTask;
+    JValue m_foregroundInfo;
+};
+
+template <typename Writer>
+static void writeAppLifeEvents(Writer& writer, Context& context)
+{
+    ApplicationManager::writeAppLifeEvents(writer, *context.m_runningApp, context.m_foregroundInfo);
+}
+
+template <typename Writer>
+static void writeAppLifeStatus(Writer& writer, Context& context)
+{
+    ApplicationManager::writeAppLifeStatus(writer, *context.m_runningApp, context.m_foregroundInfo);
+}
+
+template <typename Writer>
+static void writeRunningItem(Writer& writer, Context& context)
+{
+    context.m_runningApp->writeAPIJson(writer, true);
+}
+
+template <typename Writer>
+static void writeIds(Writer& writer, Context& context)
+{
+    context.m_lunaTask->writeIds(writer);
+}
+
+template <typename Writer>
+static void writeForegroundAppInfo(Writer& writer, Context& context)
+{
+    ApplicationManager::writeForegroundAppInfo(writer, context.m_runningApp);
+}
+
+struct Payload {
+    const char* m_name;
+    void (*m_before)(JValueWriter& writer, Context& context);
+    void (*m_after)(JsonWriter& writer, Context& context);
+};
+
+#define PAYLOAD(name, func) { name, func<JValueWriter>, func<JsonWriter> }
+
+int main(int argc, char** argv)
+{
+    static const Payload PAYLOADS[] = {
+        PAYLOAD("getAppLifeEvents", writeAppLifeEvents),
+        PAYLOAD("getAppLifeStatus", writeAppLifeStatus),
+        PAYLOAD("running item", writeRunningItem),
+        PAYLOAD("fillIds", writeIds),
+        PAYLOAD("getForegroundAppInfo", writeForegroundAppInfo)
+    };
+
+    AppDescriptionPtr appDesc = make_shared<AppDescription>("com.webos.app.browser");
+    LaunchPointPtr launchPoint = make_shared<LaunchPoint>(appDesc, "com.webos.app.browser_default");
+
+    Context context;
+    context.m_runningApp = make_shared<RunningApp>(launchPoint);
+    context.m_runningApp->setInstanceId("b3f4a2c1-8d3e-4f5a-9b6c-7d8e9f0a1b2c0");
+    context.m_runningApp->setDisplayId(0);
+    context.m_runningApp->setReason("normal");
+    context.m_foregroundInfo = pbnjson::Object();
+
+    LS::Message request;
+    JValue requestPayload = pbnjson::Object();
+    requestPayload.put("instanceId", context.m_runningApp->getInstanceId());
+    requestPayload.put("launchPointId", launchPoint->getLaunchPointId());
+    requestPayload.put("id", appDesc->getAppId());
+    requestPayload.put("displayId", 0);
+    context.m_lunaTask = make_shared<LunaTask>(request, requestPayload, nullptr);
+
+    printf("%-24s %16s %16s %10s %10s\n", "payload", "before(ns/op)", "after(ns/op)", "speedup", "identical");
+    for (const Payload& payload : PAYLOADS) {
+        JValue object = pbnjson::Object();
+        JValueWriter jvalueWriter(object);
+        jvalueWriter.beginObject();
+        payload.m_before(jvalueWriter, context);
+        jvalueWriter.endObject();
+        string expected = object.stringify();
+
+        string actual;
+        JsonWriter jsonWriter(actual);
+        jsonWriter.beginObject();
+        payload.m_after(jsonWriter, context);
+        jsonWriter.endObject();
+
+        if (JDomParser::fromString(expected) != JDomParser::fromString(actual)) {
+            fprintf(stderr, "Mismatch for %s\n%s\n%s\n", payload.m_name, expected.c_str(), actual.c_str());
+            return 1;
+        }
+
+        double before = Benchmark::measure([&]() {
+            JValue object = pbnjson::Object();
+            JValueWriter writer(object);
+            writer.beginObject();
+            payload.m_before(writer, context);
+            writer.endObject();
+            string result = object.stringify();
+            Benchmark::use(result);
+        });
+
+        string buffer;
+        double after = Benchmark::measure([&]() {
+            buffer.clear();
+            JsonWriter writer(buffer);
+            writer.beginObject();
+            payload.m_after(writer, context);
+            writer.endObject();
+            Benchmark::use(buffer);
+        });
+        printf("%-24s %16.1f %16.1f %9.1fx %10s\n", payload.m_name, before, after,
+               after > 0 ? before / after : 0.0, expected == actual ? "bytes" : "semantic");
+    }
+    return 0;
+}
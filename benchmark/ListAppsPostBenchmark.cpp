@@ -0,0 +1,298 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+// listApps subscription post cost against the number of subscribers.
+// 'before' is what postListApps did for each subscriber:
+//   parse and validate the original payload, build the projected apps and stringify them.
+// 'after' is what postListApps does now:
+//   look up the parsed payload, build one serialized payload per (devmode, properties) group
+//   from cached fields of each app and send the same string to all members of the group.
+// Both sides are modeled with pbnjson only. Luna calls are not included.
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <pbnjson.hpp>
+
+#include "Benchmark.h"
+
+using namespace pbnjson;
+using namespace std;
+
+static const int APP_COUNT = 100;
+
+// Subscribers send only a few kinds of payloads
+static const char* PAYLOADS[] = {
+    "{\"subscribe\":true}",
+    "{\"subscribe\":true,\"properties\":[\"id\",\"title\",\"icon\"]}",
+    "{\"subscribe\":true,\"properties\":[\"title\",\"visible\",\"removable\"]}",
+    "{\"subscribe\":true,\"properties\":[\"icon\",\"title\",\"id\"]}"
+};
+static const int PAYLOAD_COUNT = sizeof(PAYLOADS) / sizeof(PAYLOADS[0]);
+
+static JSchema s_schema = JSchema::AllSchema();
+
+struct App {
+    JValue m_appinfo;
+    string m_serializedJson;
+    map<string, string> m_serializedFields;
+};
+
+struct Params {
+    bool m_isValid;
+    // sorted and unique. empty means all properties
+    vector<string> m_properties;
+    string m_key;
+};
+
+static JValue createAppinfo(int index)
+{
+    JValue appinfo = pbnjson::Object();
+    string id = "com.webos.app.test" + to_string(index);
+    appinfo.put("id", id);
+    appinfo.put("title", "Test App " + to_string(index));
+    appinfo.put("version", "1.0.0");
+    appinfo.put("vendor", "LG Electronics, Inc.");
+    appinfo.put("type", "web");
+    appinfo.put("main", "index.html");
+    appinfo.put("icon", "/usr/palm/applications/" + id + "/icon.png");
+    appinfo.put("largeIcon", "/usr/palm/applications/" + id + "/largeIcon.png");
+    appinfo.put("folderPath", "/usr/palm/applications/" + id);
+    appinfo.put("visible", true);
+    appinfo.put("removable", index % 2 == 0);
+    appinfo.put("systemApp", index % 2 != 0);
+    appinfo.put("requiredMemory", 100 + index);
+    return appinfo;
+}
+
+// Same with AppDescription::getJson(properties)
+static JValue getJson(App& app, JValue& properties)
+{
+    if (properties.arraySize() == 0)
+        return app.m_appinfo;
+
+    JValue result = pbnjson::Object();
+    JValue notSpecified = pbnjson::Array();
+    set<string> notSpecifiedSet;
+    for (int i = 0; i < properties.arraySize(); ++i) {
+        string property = properties[i].asString();
+        if (app.m_appinfo.hasKey(property))
+            result.put(property, app.m_appinfo[property]);
+        else if (notSpecifiedSet.insert(property).second)
+            notSpecified.append(property);
+    }
+    if (notSpecified.arraySize() > 0)
+        result.put("notSpecified", notSpecified);
+    return result;
+}
+
+// Same with AppDescription::toProjectedJson(projection, buffer)
+static void toProjectedJson(App& app, const Params& params, string& buffer)
+{
+    if (params.m_properties.empty()) {
+        if (app.m_serializedJson.empty())
+            app.m_serializedJson = app.m_appinfo.stringify();
+        buffer += app.m_serializedJson;
+        return;
+    }
+
+    vector<size_t> notSpecified;
+    bool isFirst = true;
+    buffer += "{";
+    for (size_t i = 0; i < params.m_properties.size(); ++i) {
+        const string& property = params.m_properties[i];
+        auto it = app.m_serializedFields.find(property);
+        if (it == app.m_serializedFields.end()) {
+            string value = app.m_appinfo.hasKey(property) ? app.m_appinfo[property].stringify() : "";
+            it = app.m_serializedFields.insert(make_pair(property, std::move(value))).first;
+        }
+        if (it->second.empty()) {
+            notSpecified.push_back(i);
+            continue;
+        }
+        if (!isFirst)
+            buffer += ",";
+        buffer += "\"" + property + "\":";
+        buffer += it->second;
+        isFirst = false;
+    }
+    if (!notSpecified.empty()) {
+        if (!isFirst)
+            buffer += ",";
+        buffer += "\"notSpecified\":[";
+        for (size_t i = 0; i < notSpecified.size(); ++i) {
+            if (i > 0)
+                buffer += ",";
+            buffer += "\"" + params.m_properties[notSpecified[i]] + "\"";
+        }
+        buffer += "]";
+    }
+    buffer += "}";
+}
+
+// Same with ApplicationManager::getListAppsParams(payload) without memoization
+static Params parseParams(const string& payload)
+{
+    Params params;
+    params.m_isValid = false;
+
+    JValue requestPayload = JDomParser::fromString(payload, s_schema);
+    if (requestPayload.isNull())
+        return params;
+
+    set<string> propertySet;
+    JValue properties = requestPayload["properties"];
+    if (properties.isArray() && properties.arraySize() > 0) {
+        propertySet.insert("id");
+        for (int i = 0; i < properties.arraySize(); ++i) {
+            if (properties[i].isString())
+                propertySet.insert(properties[i].asString());
+        }
+    }
+    for (const string& property : propertySet) {
+        params.m_properties.push_back(property);
+        params.m_key += "|" + property;
+    }
+    params.m_isValid = true;
+    return params;
+}
+
+static void postBefore(vector<App>& apps, const vector<string>& subscribers)
+{
+    JValue subscriptionPayload = pbnjson::Object();
+    subscriptionPayload.put("returnValue", true);
+    subscriptionPayload.put("subscribed", true);
+    subscriptionPayload.put("change", "updated");
+
+    for (const string& payload : subscribers) {
+        JValue requestPayload = JDomParser::fromString(payload, s_schema);
+        if (requestPayload.isNull())
+            continue;
+
+        JValue properties = pbnjson::Array();
+        if (requestPayload.hasKey("properties") && requestPayload["properties"].isArray()) {
+            properties = requestPayload["properties"];
+            properties.append("id");
+        }
+
+        JValue array = pbnjson::Array();
+        for (App& app : apps) {
+            array.append(getJson(app, properties));
+        }
+        subscriptionPayload.put("apps", array);
+        string response = subscriptionPayload.stringify();
+        Benchmark::use(response);
+    }
+}
+
+static void postAfter(vector<App>& apps, map<string, Params>& paramsCache, const vector<string>& subscribers)
+{
+    JValue subscriptionPayload = pbnjson::Object();
+    subscriptionPayload.put("returnValue", true);
+    subscriptionPayload.put("subscribed", true);
+    subscriptionPayload.put("change", "updated");
+
+    string header = subscriptionPayload.stringify();
+    header.pop_back();
+    header += ",\"apps\":";
+
+    // The list changed. Serialized arrays are built again on demand
+    map<string, string> serializedApps;
+    map<string, string> groups;
+    for (const string& payload : subscribers) {
+        auto params = paramsCache.find(payload);
+        if (params == paramsCache.end())
+            params = paramsCache.insert(make_pair(payload, parseParams(payload))).first;
+        if (!params->second.m_isValid)
+            continue;
+
+        string groupKey = "N" + params->second.m_key;
+        auto it = groups.find(groupKey);
+        if (it == groups.end()) {
+            string& serialized = serializedApps[groupKey];
+            serialized = "[";
+            for (App& app : apps) {
+                if (serialized.length() > 1)
+                    serialized += ",";
+                toProjectedJson(app, params->second, serialized);
+            }
+            serialized += "]";
+            it = groups.insert(make_pair(groupKey, header + serialized + "}")).first;
+        }
+        Benchmark::use(it->second);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    static const int SIZES[] = { 1, 4, 10, 40, 100 };
+
+    s_schema = JSchema::fromFile(SAM_SCHEMA_DIR "/applicationManager.listApps.schema");
+    if (!s_schema.isInitialized()) {
+        fprintf(stderr, "Failed to load schema from %s\n", SAM_SCHEMA_DIR);
+        return 1;
+    }
+
+    vector<App> apps(APP_COUNT);
+    for (int i = 0; i < APP_COUNT; ++i) {
+        apps[i].m_appinfo = createAppinfo(i);
+    }
+
+    // Both paths should send the same apps
+    for (int i = 0; i < PAYLOAD_COUNT; ++i) {
+        JValue properties = pbnjson::Array();
+        Params params = parseParams(PAYLOADS[i]);
+        for (const string& property : params.m_properties) {
+            properties.append(property);
+        }
+        string expected = getJson(apps[0], properties).stringify();
+        string actual;
+        toProjectedJson(apps[0], params, actual);
+        if (JDomParser::fromString(expected) != JDomParser::fromString(actual)) {
+            fprintf(stderr, "Mismatch for %s\n%s\n%s\n", PAYLOADS[i], expected.c_str(), actual.c_str());
+            return 1;
+        }
+    }
+
+    printf("apps(%d) distinct payloads(%d)\n", APP_COUNT, PAYLOAD_COUNT);
+    Benchmark::printHeader("postListApps", "subscribers");
+    for (int size : SIZES) {
+        vector<string> subscribers;
+        for (int i = 0; i < size; ++i) {
+            subscribers.push_back(PAYLOADS[i % PAYLOAD_COUNT]);
+        }
+
+        double before = Benchmark::measure([&]() {
+            postBefore(apps, subscribers);
+        });
+
+        // Parameters are parsed when the subscription is added
+        map<string, Params> paramsCache;
+        double after = Benchmark::measure([&]() {
+            // Every post follows a change. Cached fields are invalidated with it
+            for (App& app : apps) {
+                app.m_serializedJson.clear();
+                app.m_serializedFields.clear();
+            }
+            postAfter(apps, paramsCache, subscribers);
+        });
+        Benchmark::printRow(size, before, after);
+    }
+    return 0;
+}
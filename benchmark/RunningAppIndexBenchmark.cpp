@@ -0,0 +1,112 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+// RunningAppList lookup cost against the number of running apps.
+// 'before' is linear scan over instanceId map which RunningAppList did for getByPid, getByAppId, etc.
+// 'after' is SecondaryIndex which RunningAppList uses now.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "util/SecondaryIndex.h"
+
+using namespace std;
+
+struct Item {
+    string m_instanceId;
+    string m_appId;
+    pid_t m_pid;
+};
+typedef shared_ptr<Item> ItemPtr;
+
+static ItemPtr findByPid(const map<string, ItemPtr>& items, pid_t pid)
+{
+    for (auto it = items.begin(); it != items.end(); ++it) {
+        if (it->second->m_pid == pid)
+            return it->second;
+    }
+    return nullptr;
+}
+
+static ItemPtr findByAppId(const map<string, ItemPtr>& items, const string& appId)
+{
+    for (auto it = items.begin(); it != items.end(); ++it) {
+        if (it->second->m_appId == appId)
+            return it->second;
+    }
+    return nullptr;
+}
+
+int main(int argc, char** argv)
+{
+    static const int SIZES[] = { 1, 10, 30, 100, 300, 1000 };
+
+    Benchmark::printHeader("getByPid", "apps");
+    for (int size : SIZES) {
+        map<string, ItemPtr> items;
+        SecondaryIndex<pid_t, ItemPtr> pidIndex;
+        vector<pid_t> pids;
+        for (int i = 0; i < size; ++i) {
+            ItemPtr item = make_shared<Item>();
+            item->m_instanceId = "instance-" + to_string(i);
+            item->m_appId = "com.webos.app.test" + to_string(i);
+            item->m_pid = 1000 + i;
+            items[item->m_instanceId] = item;
+            pidIndex.add(item->m_pid, item->m_instanceId, item);
+            pids.push_back(item->m_pid);
+        }
+
+        size_t next = 0;
+        double before = Benchmark::measure([&]() {
+            Benchmark::use(findByPid(items, pids[next++ % pids.size()]));
+        });
+        next = 0;
+        double after = Benchmark::measure([&]() {
+            Benchmark::use(pidIndex.find(pids[next++ % pids.size()]));
+        });
+        Benchmark::printRow(size, before, after);
+    }
+
+    Benchmark::printHeader("getByAppId", "apps");
+    for (int size : SIZES) {
+        map<string, ItemPtr> items;
+        SecondaryIndex<string, ItemPtr> appIdIndex;
+        vector<string> appIds;
+        for (int i = 0; i < size; ++i) {
+            ItemPtr item = make_shared<Item>();
+            item->m_instanceId = "instance-" + to_string(i);
+            item->m_appId = "com.webos.app.test" + to_string(i);
+            item->m_pid = 1000 + i;
+            items[item->m_instanceId] = item;
+            appIdIndex.add(item->m_appId, item->m_instanceId, item);
+            appIds.push_back(item->m_appId);
+        }
+
+        size_t next = 0;
+        double before = Benchmark::measure([&]() {
+            Benchmark::use(findByAppId(items, appIds[next++ % appIds.size()]));
+        });
+        next = 0;
+        double after = Benchmark::measure([&]() {
+            Benchmark::use(appIdIndex.find(appIds[next++ % appIds.size()]));
+        });
+        Benchmark::printRow(size, before, after);
+    }
+    return 0;
+}
@@ -0,0 +1,145 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+// Native app spawn cost against the size of the base environment.
+// 'before' copies the container environment map for each launch and serializes all of it.
+// 'after' is NativeProcess::buildEnvp() which NativeProcess::run() uses. It serializes only
+// per-process variables and references the shared base environment.
+// The second table also spawns /bin/true with the result.
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <spawn.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+
+#include "Benchmark.h"
+#include "util/NativeProcess.h"
+
+using namespace std;
+
+// Variables which NativeContainer adds for each process
+static map<string, string> createOverlay()
+{
+    map<string, string> overlay;
+    overlay["INSTANCE_ID"] = "b3f4a2c1-8d3e-4f5a-9b6c-7d8e9f0a1b2c0";
+    overlay["LAUNCHPOINT_ID"] = "com.webos.app.test_default";
+    overlay["APP_ID"] = "com.webos.app.test";
+    overlay["DISPLAY_ID"] = "0";
+    overlay["LS2_NAME"] = "com.webos.app.test-1";
+    return overlay;
+}
+
+static map<string, string> createBase(int size)
+{
+    map<string, string> base;
+    base["PATH"] = "/usr/sbin:/usr/bin:/sbin:/bin";
+    base["HOME"] = "/home/root";
+    base["XDG_RUNTIME_DIR"] = "/tmp/xdg";
+    for (int i = (int) base.size(); i < size; ++i) {
+        base["SAM_VARIABLE_" + to_string(i)] = "/usr/share/some/configured/path/" + to_string(i);
+    }
+    return base;
+}
+
+// NativeContainer copied its environment map into each process and NativeProcess serialized all of it
+static void prepareBefore(const map<string, string>& base, const map<string, string>& overlay,
+                          vector<string>& strings, vector<const char*>& envp)
+{
+    map<string, string> environments = base;
+    for (auto it = overlay.begin(); it != overlay.end(); ++it) {
+        environments[it->first] = it->second;
+    }
+    for (auto it = environments.begin(); it != environments.end(); ++it) {
+        strings.push_back(it->first + "=" + it->second);
+    }
+    for (auto it = strings.begin(); it != strings.end(); ++it) {
+        envp.push_back(it->c_str());
+    }
+    envp.push_back(nullptr);
+}
+
+static void spawnTrue(const vector<const char*>& envp)
+{
+    static const char* ARGV[] = { "/bin/true", nullptr };
+    pid_t pid = 0;
+    if (posix_spawn(&pid, ARGV[0], nullptr, nullptr, const_cast<char**>(ARGV), const_cast<char**>(envp.data())) != 0) {
+        perror("posix_spawn");
+        exit(1);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+}
+
+int main(int argc, char** argv)
+{
+    static const int SIZES[] = { 10, 30, 100, 300 };
+
+    map<string, string> overlay = createOverlay();
+
+    Benchmark::printHeader("prepare environment", "base vars");
+    for (int size : SIZES) {
+        map<string, string> base = createBase(size);
+        vector<string> serialized;
+        for (auto it = base.begin(); it != base.end(); ++it) {
+            serialized.push_back(it->first + "=" + it->second);
+        }
+        BaseEnvironmentPtr baseEnvironment = make_shared<const vector<string>>(std::move(serialized));
+
+        double before = Benchmark::measure([&]() {
+            vector<string> strings;
+            vector<const char*> envp;
+            prepareBefore(base, overlay, strings, envp);
+            Benchmark::use(envp);
+        });
+        double after = Benchmark::measure([&]() {
+            vector<string> strings;
+            vector<const char*> envp;
+            NativeProcess::buildEnvp(baseEnvironment, overlay, strings, envp);
+            Benchmark::use(envp);
+        });
+        Benchmark::printRow(size, before, after);
+    }
+
+    Benchmark::printHeader("prepare environment and exec /bin/true", "base vars");
+    for (int size : SIZES) {
+        map<string, string> base = createBase(size);
+        vector<string> serialized;
+        for (auto it = base.begin(); it != base.end(); ++it) {
+            serialized.push_back(it->first + "=" + it->second);
+        }
+        BaseEnvironmentPtr baseEnvironment = make_shared<const vector<string>>(std::move(serialized));
+
+        double before = Benchmark::measure([&]() {
+            vector<string> strings;
+            vector<const char*> envp;
+            prepareBefore(base, overlay, strings, envp);
+            spawnTrue(envp);
+        });
+        double after = Benchmark::measure([&]() {
+            vector<string> strings;
+            vector<const char*> envp;
+            NativeProcess::buildEnvp(baseEnvironment, overlay, strings, envp);
+            spawnTrue(envp);
+        });
+        Benchmark::printRow(size, before, after);
+    }
+    return 0;
+}
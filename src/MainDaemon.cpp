@@ -25,7 +25,9 @@
 #include <glib.h>
 #include <boost/bind.hpp>
 
+#include "base/AppDescriptionCache.h"
 #include "base/AppDescriptionList.h"
+#include "base/BootTimeline.h"
 #include "bus/client/AppInstallService.h"
 #include "bus/client/Bootd.h"
 #include "bus/client/Configd.h"
@@ -37,15 +39,19 @@
 #include "bus/client/SettingService.h"
 #include "bus/client/WAM.h"
 #include "bus/service/ApplicationManager.h"
+#include "bus/service/SchemaChecker.h"
 #include "conf/RuntimeInfo.h"
 #include "conf/SAMConf.h"
 #include "util/File.h"
+#include "util/ChildReaper.h"
+#include "util/ForkServer.h"
 #include "util/JValueUtil.h"
 
 
 MainDaemon::MainDaemon()
     : m_isCBDGenerated(false),
-      m_isConfigsReceived(false)
+      m_isConfigsReceived(false),
+      m_initializeTime(0)
 {
     setClassName("MainDaemon");
     m_mainLoop = g_main_loop_new(NULL, FALSE);
@@ -58,25 +64,61 @@ MainDaemon::~MainDaemon()
     }
 }
 
+static void addInitPhase(const char* name, long long& startTime)
+{
+    long long now = Time::getCurrentTimeUs();
+    BootTimeline::getInstance().addDuration(name, "init", startTime, now);
+    startTime = now;
+}
+
 void MainDaemon::initialize()
 {
+    m_initializeTime = Time::getCurrentTimeUs();
+    long long startTime = m_initializeTime;
+
     RuntimeInfo::getInstance().initialize();
+    addInitPhase("RuntimeInfo::initialize", startTime);
     SAMConf::getInstance().initialize();
+    addInitPhase("SAMConf::initialize", startTime);
+    // ChildReaper and ForkServer should be started before any thread is created
+    ChildReaper::getInstance().start();
+    addInitPhase("ChildReaper::start", startTime);
+    if (SAMConf::getInstance().isForkServerEnabled()) {
+        ForkServer::getInstance().start();
+        addInitPhase("ForkServer::start", startTime);
+    }
+    SchemaChecker::getInstance().initialize();
+    addInitPhase("SchemaChecker::initialize", startTime);
     AppDescriptionList::getInstance().scanFull();
+    addInitPhase("AppDescriptionList::scanFull", startTime);
+    AppDescriptionList::getInstance().startWatch();
+    addInitPhase("AppDescriptionList::startWatch", startTime);
 
     if (!ApplicationManager::getInstance().attach(m_mainLoop))
         return;
+    addInitPhase("ApplicationManager::attach", startTime);
 
     AppInstallService::getInstance().initialize();
+    addInitPhase("AppInstallService::initialize", startTime);
     Bootd::getInstance().initialize();
+    addInitPhase("Bootd::initialize", startTime);
     Configd::getInstance().initialize();
+    addInitPhase("Configd::initialize", startTime);
     DB8::getInstance().initialize();
+    addInitPhase("DB8::initialize", startTime);
     LSM::getInstance().initialize();
+    addInitPhase("LSM::initialize", startTime);
     MemoryManager::getInstance().initialize();
+    addInitPhase("MemoryManager::initialize", startTime);
     NativeContainer::getInstance().initialize();
+    addInitPhase("NativeContainer::initialize", startTime);
     Notification::getInstance().initialize();
+    addInitPhase("Notification::initialize", startTime);
     SettingService::getInstance().initialize();
+    addInitPhase("SettingService::initialize", startTime);
     WAM::getInstance().initialize();
+    addInitPhase("WAM::initialize", startTime);
+    BootTimeline::getInstance().addDuration("MainDaemon::initialize", "init", m_initializeTime, startTime);
 
     Bootd::getInstance().EventGetBootStatus.connect(boost::bind(&MainDaemon::onGetBootStatus, this, boost::placeholders::_1));
     Configd::getInstance().EventGetConfigs.connect(boost::bind(&MainDaemon::onGetConfigs, this, boost::placeholders::_1));
@@ -90,11 +132,18 @@ void MainDaemon::finalize()
     DB8::getInstance().finalize();
     LSM::getInstance().finalize();
     MemoryManager::getInstance().finalize();
+    NativeContainer::getInstance().finalize();
     Notification::getInstance().finalize();
     SettingService::getInstance().finalize();
     WAM::getInstance().finalize();
 
     ApplicationManager::getInstance().detach();
+    AppDescriptionList::getInstance().stopWatch();
+    SchemaChecker::getInstance().finalize();
+    AppDescriptionCache::getInstance().save();
+    RuntimeInfo::getInstance().finalize();
+    ForkServer::getInstance().stop();
+    ChildReaper::getInstance().stop();
 }
 
 void MainDaemon::start()
@@ -116,6 +165,7 @@ void MainDaemon::onGetBootStatus(const JValue& subscriptionPayload)
         return;
     }
     m_isCBDGenerated = true;
+    BootTimeline::getInstance().addFirst("core-boot-done", "precondition");
     checkPreconditions();
 }
 
@@ -132,6 +182,7 @@ void MainDaemon::onGetConfigs(const JValue& responsePayload)
         SAMConf::getInstance().setKeepAliveApps(keepAliveApps);
     }
     m_isConfigsReceived = true;
+    BootTimeline::getInstance().addFirst("getConfigs", "precondition");
     checkPreconditions();
 }
 
@@ -152,6 +203,10 @@ void MainDaemon::checkPreconditions()
     Logger::info(getClassName(), __FUNCTION__, "All initial components are ready");
     isFired = true;
 
+    long long startTime = Time::getCurrentTimeUs();
     ApplicationManager::getInstance().enablePosting();
+    BootTimeline::getInstance().addDuration("ApplicationManager::enablePosting", "init", startTime);
+    BootTimeline::getInstance().addDuration("ready", "init", m_initializeTime);
+    BootTimeline::getInstance().dump();
 }
 
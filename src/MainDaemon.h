@@ -45,6 +45,8 @@ private:
 
     bool m_isCBDGenerated;
     bool m_isConfigsReceived;
+    // monotonic time(us) when initialize() is called
+    long long m_initializeTime;
 
     GMainLoop *m_mainLoop;
 
@@ -19,10 +19,12 @@
 #include <sys/stat.h>
 #include <string>
 #include <cstring>
+#include <set>
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
 
 #include "base/AppDescription.h"
+#include "base/AppDescriptionCache.h"
 #include "bus/client/SettingService.h"
 #include "conf/SAMConf.h"
 #include "util/JValueUtil.h"
@@ -190,6 +192,8 @@ AppDescription::~AppDescription()
 bool AppDescription::scan()
 {
     m_isScanned = false;
+    m_serializedFields.clear();
+    m_serializedJson.clear();
     if (m_appId.empty() || m_folderPath.empty() || m_appLocation == AppLocation::AppLocation_None) {
         Logger::warning(CLASS_NAME, __FUNCTION__, m_appId, "Required members are not set");
         return false;
@@ -237,6 +241,31 @@ void AppDescription::applyFolderPath(string& path)
     path = File::join(m_folderPath, path);
 }
 
+AppDescription::Projection::Projection()
+{
+}
+
+AppDescription::Projection::Projection(const JValue& properties, bool includeId)
+{
+    if (!properties.isArray() || properties.arraySize() == 0)
+        return;
+
+    // Order and duplication of properties don't change the result
+    set<string> propertySet;
+    for (int i = 0; i < properties.arraySize(); ++i) {
+        if (properties[i].isString())
+            propertySet.insert(properties[i].asString());
+    }
+    if (includeId)
+        propertySet.insert("id");
+
+    for (const string& property : propertySet) {
+        m_properties.push_back(property);
+        m_names.push_back(JValue(property).stringify());
+        m_key += "|" + property;
+    }
+}
+
 JValue AppDescription::getJson(JValue& properties)
 {
     if (properties.isNull() || !properties.isArray()) {
@@ -248,6 +277,7 @@ JValue AppDescription::getJson(JValue& properties)
 
     JValue result = pbnjson::Object();
     JValue notSpecified = pbnjson::Array();
+    set<string> notSpecifiedSet;
 
     // get selected props from appinfo
     for (int i = 0; i < properties.arraySize(); ++i) {
@@ -256,8 +286,8 @@ JValue AppDescription::getJson(JValue& properties)
             continue;
         if (m_appinfo.hasKey(property))
             result.put(property, m_appinfo[property]);
-        else
-            JValueUtil::addUniqueItemToArray(notSpecified, property);
+        else if (notSpecifiedSet.insert(property).second)
+            notSpecified.append(property);
     }
 
     if (notSpecified.arraySize() > 0)
@@ -266,6 +296,51 @@ JValue AppDescription::getJson(JValue& properties)
     return result;
 }
 
+void AppDescription::toProjectedJson(const Projection& projection, string& buffer)
+{
+    if (projection.isAll()) {
+        if (m_serializedJson.empty())
+            m_serializedJson = m_appinfo.stringify();
+        buffer += m_serializedJson;
+        return;
+    }
+
+    vector<size_t> notSpecified;
+    bool isFirst = true;
+    buffer += "{";
+    for (size_t i = 0; i < projection.m_properties.size(); ++i) {
+        const string& property = projection.m_properties[i];
+        auto it = m_serializedFields.find(property);
+        if (it == m_serializedFields.end()) {
+            string value = m_appinfo.hasKey(property) ? m_appinfo[property].stringify() : "";
+            it = m_serializedFields.insert(make_pair(property, std::move(value))).first;
+        }
+        if (it->second.empty()) {
+            notSpecified.push_back(i);
+            continue;
+        }
+        if (!isFirst)
+            buffer += ",";
+        buffer += projection.m_names[i];
+        buffer += ":";
+        buffer += it->second;
+        isFirst = false;
+    }
+
+    if (!notSpecified.empty()) {
+        if (!isFirst)
+            buffer += ",";
+        buffer += "\"notSpecified\":[";
+        for (size_t i = 0; i < notSpecified.size(); ++i) {
+            if (i > 0)
+                buffer += ",";
+            buffer += projection.m_names[notSpecified[i]];
+        }
+        buffer += "]";
+    }
+    buffer += "}";
+}
+
 bool AppDescription::loadAppinfo()
 {
     // Specify application description depending on available locale string.
@@ -276,15 +351,6 @@ bool AppDescription::loadAppinfo()
     // or resources/<language>/<script>/<region>/appinfo.json respectively.
     // (Note that the script dir goes in between the language and region dirs.)
     const string appinfoPath = File::join(m_folderPath, "/appinfo.json");
-    m_appinfo = JDomParser::fromFile(appinfoPath.c_str(), JValueUtil::getSchema("ApplicationDescription"));
-    if (!isValidAppInfo(m_appinfo)) {
-        Logger::warning(CLASS_NAME, __FUNCTION__, m_appId, Logger::format("Failed to parse appinfo.json(%s)", appinfoPath.c_str()));
-        m_appinfo = pbnjson::JValue();
-        return false;
-    }
-
-    /// Add folderPath to JSON
-    m_appinfo.put("folderPath", m_folderPath);
 
     vector<string> localizationDirs;
     string resourcePath = m_folderPath + "/resources/" + SAMConf::getInstance().getLanguage() + "/";
@@ -296,6 +362,26 @@ bool AppDescription::loadAppinfo()
     resourcePath += SAMConf::getInstance().getRegion() + "/";
     localizationDirs.push_back(resourcePath);
 
+    // Cached appinfo is valid only if all input files are not changed
+    string stamp = std::to_string((int) m_appLocation) + "|" + resourcePath.substr(m_folderPath.length()) + "|" + File::getStamp(appinfoPath);
+    for (const auto& localizationDir : localizationDirs) {
+        stamp += "|" + File::getStamp(localizationDir + "appinfo.json");
+    }
+    if (AppDescriptionCache::getInstance().get(m_folderPath, stamp, m_appinfo)) {
+        if (isValidAppInfo(m_appinfo))
+            return true;
+    }
+
+    m_appinfo = JDomParser::fromFile(appinfoPath.c_str(), JValueUtil::getSchema("ApplicationDescription"));
+    if (!isValidAppInfo(m_appinfo)) {
+        Logger::warning(CLASS_NAME, __FUNCTION__, m_appId, Logger::format("Failed to parse appinfo.json(%s)", appinfoPath.c_str()));
+        m_appinfo = pbnjson::JValue();
+        return false;
+    }
+
+    /// Add folderPath to JSON
+    m_appinfo.put("folderPath", m_folderPath);
+
     // apply localization (overwrite from low to high)
     for (const auto& localizationDir : localizationDirs) {
         string AbsoluteLocaleAppinfoPath = localizationDir + "appinfo.json";
@@ -348,6 +434,7 @@ bool AppDescription::loadAppinfo()
             }
         }
     }
+    AppDescriptionCache::getInstance().put(m_folderPath, stamp, m_appinfo);
     return true;
 }
 
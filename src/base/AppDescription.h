@@ -18,11 +18,13 @@
 #define BASE_APPDESCRIPTION_H_
 
 #include <list>
+#include <map>
 #include <memory>
 #include <pbnjson.hpp>
 #include <stdint.h>
 #include <string>
 #include <tuple>
+#include <vector>
 
 #include "conf/RuntimeInfo.h"
 #include "interface/IClassName.h"
@@ -67,6 +69,32 @@ typedef tuple<uint16_t, uint16_t, uint16_t> AppIntVersion;
 class AppDescription {
 friend class AppDescriptionList;
 public:
+    // Compiled 'properties'. Compile once and use it for all AppDescriptions.
+    class Projection {
+    public:
+        Projection();
+        // 'id' is added if includeId is true and properties is not empty (listApps)
+        Projection(const JValue& properties, bool includeId = false);
+
+        bool isAll() const
+        {
+            return m_properties.empty();
+        }
+        // Same set of properties has same key regardless of order or duplication
+        const string& getKey() const
+        {
+            return m_key;
+        }
+
+    private:
+        friend class AppDescription;
+
+        vector<string> m_properties;
+        // Serialized (quoted and escaped) names of m_properties
+        vector<string> m_names;
+        string m_key;
+    };
+
     static string toString(const AppStatusEvent& event);
 
     static string toString(AppType type);
@@ -96,6 +124,8 @@ public:
     }
 
     JValue getJson(JValue& properties);
+    // Appends the same result with getJson(properties).stringify() to buffer
+    void toProjectedJson(const Projection& projection, string& buffer);
 
     JValue& getJson()
     {
@@ -341,6 +371,9 @@ private:
     bool m_isLocked;
     bool m_isScanned;
 
+    // Serialized value of each projected property. Empty string means the property is not specified.
+    map<string, string> m_serializedFields;
+    string m_serializedJson;
 };
 
 #endif // BASE_APPDESCRIPTION_H_
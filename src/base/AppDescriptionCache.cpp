@@ -0,0 +1,157 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "base/AppDescriptionCache.h"
+
+#include "Environment.h"
+#include "conf/RuntimeInfo.h"
+#include "util/File.h"
+#include "util/JValueUtil.h"
+#include "util/Logger.h"
+
+const int AppDescriptionCache::VERSION = 1;
+
+gboolean AppDescriptionCache::onSave(gpointer data)
+{
+    getInstance().m_saveTimer = 0;
+    getInstance().save();
+    return G_SOURCE_REMOVE;
+}
+
+AppDescriptionCache::AppDescriptionCache()
+    : m_isDirty(false),
+      m_saveTimer(0),
+      m_hits(0),
+      m_misses(0)
+{
+    setClassName("AppDescriptionCache");
+    m_entries = pbnjson::Object();
+    m_newEntries = pbnjson::Object();
+}
+
+AppDescriptionCache::~AppDescriptionCache()
+{
+    if (m_saveTimer != 0)
+        g_source_remove(m_saveTimer);
+}
+
+void AppDescriptionCache::load()
+{
+    m_entries = pbnjson::Object();
+    m_newEntries = pbnjson::Object();
+
+    JValue database = JDomParser::fromFile(PATH_APPINFO_CACHE);
+    if (database.isNull() || !database.isObject()) {
+        Logger::info(getClassName(), __FUNCTION__, "Cache is empty");
+        return;
+    }
+
+    JValue header;
+    JValue entries;
+    if (!JValueUtil::getValue(database, "header", header) || header != makeHeader() ||
+        !JValueUtil::getValue(database, "entries", entries) || !entries.isObject()) {
+        Logger::info(getClassName(), __FUNCTION__, "Cache is outdated");
+        m_isDirty = true;
+        return;
+    }
+    m_entries = entries;
+}
+
+void AppDescriptionCache::scheduleSave()
+{
+    // Timer is not restarted. Continuous changes are still written every SAVE_DELAY
+    if (m_saveTimer != 0)
+        return;
+    m_saveTimer = g_timeout_add(SAVE_DELAY, onSave, nullptr);
+}
+
+void AppDescriptionCache::save()
+{
+    if (m_saveTimer != 0) {
+        g_source_remove(m_saveTimer);
+        m_saveTimer = 0;
+    }
+
+    lock_guard<mutex> lock(m_mutex);
+    // m_newEntries has only entries used in this session. Size is different if some apps are removed.
+    if (!m_isDirty && m_newEntries.objectSize() == m_entries.objectSize())
+        return;
+
+    JValue database = pbnjson::Object();
+    database.put("header", makeHeader());
+    database.put("entries", m_newEntries);
+    if (!File::writeFileAtomically(PATH_APPINFO_CACHE, database.stringify())) {
+        Logger::warning(getClassName(), __FUNCTION__, PATH_APPINFO_CACHE, "Failed to save cache");
+        return;
+    }
+    m_entries = m_newEntries;
+    m_isDirty = false;
+    Logger::info(getClassName(), __FUNCTION__, Logger::format("Cache is saved: hits(%d) misses(%d)", m_hits, m_misses));
+}
+
+bool AppDescriptionCache::get(const string& folderPath, const string& stamp, JValue& appinfo)
+{
+    lock_guard<mutex> lock(m_mutex);
+
+    JValue entry;
+    string cachedStamp;
+    if (!JValueUtil::getValue(m_entries, folderPath, entry) ||
+        !JValueUtil::getValue(entry, "stamp", cachedStamp) || cachedStamp != stamp ||
+        !JValueUtil::getValue(entry, "appinfo", appinfo) || !appinfo.isObject()) {
+        m_misses++;
+        return false;
+    }
+
+    if (!m_newEntries.hasKey(folderPath))
+        m_newEntries.put(folderPath, entry);
+    appinfo = appinfo.duplicate();
+    m_hits++;
+    return true;
+}
+
+void AppDescriptionCache::put(const string& folderPath, const string& stamp, const JValue& appinfo)
+{
+    lock_guard<mutex> lock(m_mutex);
+
+    JValue entry = pbnjson::Object();
+    entry.put("stamp", stamp);
+    entry.put("appinfo", appinfo.duplicate());
+    m_newEntries.put(folderPath, entry);
+    m_isDirty = true;
+}
+
+void AppDescriptionCache::toJson(JValue& json)
+{
+    lock_guard<mutex> lock(m_mutex);
+
+    json.put("hits", m_hits);
+    json.put("misses", m_misses);
+    if (m_hits + m_misses > 0)
+        json.put("hitRatio", (double) m_hits / (m_hits + m_misses));
+    else
+        json.put("hitRatio", 0.0);
+}
+
+JValue AppDescriptionCache::makeHeader()
+{
+    // Any change of followings can change the result of AppDescription::loadAppinfo
+    JValue header = pbnjson::Object();
+    header.put("version", VERSION);
+    header.put("deviceType", RuntimeInfo::getInstance().getDeviceType());
+    header.put("samConf", File::getStamp(PATH_RO_SAM_CONF));
+    header.put("schema", File::getStamp(string(PATH_SAM_SCHEMAS) + "ApplicationDescription.schema"));
+    return header;
+}
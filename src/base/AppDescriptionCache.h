@@ -0,0 +1,72 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef BASE_APPDESCRIPTIONCACHE_H_
+#define BASE_APPDESCRIPTIONCACHE_H_
+
+#include <iostream>
+#include <mutex>
+#include <glib.h>
+#include <pbnjson.hpp>
+
+#include "interface/IClassName.h"
+#include "interface/ISingleton.h"
+
+using namespace std;
+using namespace pbnjson;
+
+// Persistent cache of localized appinfo.json keyed by folderPath.
+// Each entry is valid only if the stamp (location, locale, appinfo.json and locale overlays) is same.
+class AppDescriptionCache : public ISingleton<AppDescriptionCache>,
+                            public IClassName {
+friend class ISingleton<AppDescriptionCache>;
+public:
+    virtual ~AppDescriptionCache();
+
+    void load();
+    // Changes in SAVE_DELAY are written at once. So single app changes don't rewrite the file one by one
+    void scheduleSave();
+    // Writes pending changes immediately
+    void save();
+
+    // These can be called in scanning threads
+    bool get(const string& folderPath, const string& stamp, JValue& appinfo);
+    void put(const string& folderPath, const string& stamp, const JValue& appinfo);
+
+    void toJson(JValue& json);
+
+private:
+    static const int VERSION;
+    static const int SAVE_DELAY = 3000; // 3 seconds
+
+    static gboolean onSave(gpointer data);
+
+    AppDescriptionCache();
+
+    JValue makeHeader();
+
+    mutex m_mutex;
+
+    JValue m_entries;
+    JValue m_newEntries;
+    bool m_isDirty;
+    guint m_saveTimer;
+
+    int m_hits;
+    int m_misses;
+};
+
+#endif /* BASE_APPDESCRIPTIONCACHE_H_ */
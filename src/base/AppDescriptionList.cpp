@@ -16,6 +16,15 @@
 
 #include "base/AppDescriptionList.h"
 
+#include <dirent.h>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <glib-unix.h>
+#include <sys/inotify.h>
+
+#include "base/AppDescriptionCache.h"
+#include "base/BootTimeline.h"
 #include "base/LaunchPointList.h"
 #include "bus/service/ApplicationManager.h"
 #include "conf/SAMConf.h"
@@ -54,22 +63,36 @@ bool AppDescriptionList::compare(AppDescriptionPtr me, AppDescriptionPtr another
 }
 
 AppDescriptionList::AppDescriptionList()
+    : m_version(0),
+      m_inotifyFd(-1),
+      m_inotifySource(0),
+      m_watchTimer(0)
 {
     setClassName("AppDescriptionList");
 }
 
 AppDescriptionList::~AppDescriptionList()
 {
+    stopWatch();
 }
 
 void AppDescriptionList::changeLocale()
 {
     for (const auto& appDesc : m_map) {
         appDesc.second->scan();
+        LaunchPointList::getInstance().reindexByAppId(appDesc.first);
     }
+    onChanged();
+    AppDescriptionCache::getInstance().scheduleSave();
 }
 
 void AppDescriptionList::scanApp(const string& appId)
+{
+    rescanApp(appId);
+    AppDescriptionCache::getInstance().scheduleSave();
+}
+
+void AppDescriptionList::rescanApp(const string& appId, bool isWatchEvent)
 {
     AppDescriptionPtr newAppDesc = AppDescriptionList::getInstance().create(appId);
     if (newAppDesc == nullptr) {
@@ -77,6 +100,7 @@ void AppDescriptionList::scanApp(const string& appId)
         return;
     }
 
+    bool isFolderFound = false;
     JValue applicationPaths = SAMConf::getInstance().getApplicationPaths();
     for (int i = applicationPaths.arraySize() - 1; i >= 0; i--) {
         string path = "";
@@ -100,12 +124,24 @@ void AppDescriptionList::scanApp(const string& appId)
             Logger::warning(getClassName(), __FUNCTION__, appId, folderPath + " is not exist");
             continue;
         }
+        isFolderFound = true;
 
         if (newAppDesc->scan(folderPath, appLocation)) {
             break;
         }
     }
 
+    if (!newAppDesc->isScanned() && isWatchEvent) {
+        // The folder can be in the middle of copy or appinfo.json can be half written.
+        // Keep current AppDescription. Next event on the folder triggers rescan again.
+        if (isFolderFound) {
+            Logger::warning(getClassName(), __FUNCTION__, appId, "Failed to scan AppDescription. Keep current one");
+            return;
+        }
+        Logger::info(getClassName(), __FUNCTION__, appId, "App folder is removed from all ApplicationPaths");
+        AppDescriptionList::getInstance().removeByAppId(appId, false);
+        return;
+    }
     if (!newAppDesc->isScanned()) {
         Logger::warning(getClassName(), __FUNCTION__, appId, "Failed to scan AppDescription");
         AppDescriptionList::getInstance().removeByAppId(appId);
@@ -117,6 +153,9 @@ void AppDescriptionList::scanApp(const string& appId)
 
 void AppDescriptionList::scanFull()
 {
+    AppDescriptionCache::getInstance().load();
+
+    vector<ScanJob> jobs;
     JValue applicationPaths = SAMConf::getInstance().getApplicationPaths();
     for (int i = 0; i < applicationPaths.arraySize(); i++) {
         string path = "";
@@ -146,12 +185,184 @@ void AppDescriptionList::scanFull()
                             Logger::format("Directory is not exist: path(%s) typeByDir(%s)", path.c_str(), typeByDir.c_str()));
             continue;
         }
-        scanDir(path, appLocation);
+        collectDir(path, appLocation, jobs);
     }
-    return;
+    runScanJobs(jobs);
+    AppDescriptionCache::getInstance().scheduleSave();
 }
 
 void AppDescriptionList::scanDir(const string& path, const AppLocation& appLocation)
+{
+    vector<ScanJob> jobs;
+    collectDir(path, appLocation, jobs);
+    runScanJobs(jobs);
+}
+
+void AppDescriptionList::startWatch()
+{
+    if (m_inotifyFd >= 0)
+        return;
+    if (SAMConf::getInstance().getAppWatchDelay() < 0) {
+        Logger::info(getClassName(), __FUNCTION__, "Watching ApplicationPaths is disabled");
+        return;
+    }
+
+    m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotifyFd < 0) {
+        Logger::warning(getClassName(), __FUNCTION__, Logger::format("Failed to init inotify: %s", strerror(errno)));
+        return;
+    }
+
+    JValue applicationPaths = SAMConf::getInstance().getApplicationPaths();
+    for (int i = 0; i < applicationPaths.arraySize(); i++) {
+        string path = "";
+        if (!JValueUtil::getValue(applicationPaths[i], "path", path) || path.empty() || !File::isDirectory(path))
+            continue;
+
+        addWatch(path);
+
+        DIR* dir = opendir(path.c_str());
+        if (dir == NULL)
+            continue;
+        struct dirent* entry;
+        while ((entry = readdir(dir)) != NULL) {
+            if (entry->d_name[0] == '.')
+                continue;
+            string folderPath = File::join(path, entry->d_name);
+            if (File::isDirectory(folderPath))
+                addWatch(folderPath, entry->d_name);
+        }
+        closedir(dir);
+    }
+    m_inotifySource = g_unix_fd_add(m_inotifyFd, G_IO_IN, onAppDirChanged, this);
+    Logger::info(getClassName(), __FUNCTION__, Logger::format("Watching %d directories", (int) m_watches.size()));
+}
+
+void AppDescriptionList::stopWatch()
+{
+    if (m_watchTimer != 0) {
+        g_source_remove(m_watchTimer);
+        m_watchTimer = 0;
+    }
+    if (m_inotifySource != 0) {
+        g_source_remove(m_inotifySource);
+        m_inotifySource = 0;
+    }
+    if (m_inotifyFd >= 0) {
+        close(m_inotifyFd);
+        m_inotifyFd = -1;
+    }
+    m_watches.clear();
+    m_changedAppIds.clear();
+}
+
+gboolean AppDescriptionList::onAppDirChanged(gint fd, GIOCondition condition, gpointer data)
+{
+    char buffer[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+
+    while (true) {
+        ssize_t length = read(fd, buffer, sizeof(buffer));
+        if (length <= 0)
+            break;
+
+        for (char* ptr = buffer; ptr < buffer + length; ) {
+            const struct inotify_event* event = (const struct inotify_event*) ptr;
+            ptr += sizeof(struct inotify_event) + event->len;
+            getInstance().onWatchEvent(event->wd, event->mask, event->len > 0 ? event->name : "");
+        }
+    }
+
+    if (getInstance().m_changedAppIds.empty())
+        return G_SOURCE_CONTINUE;
+
+    // Restart timer whenever new events come. So a burst of changes is handled at once.
+    if (getInstance().m_watchTimer != 0)
+        g_source_remove(getInstance().m_watchTimer);
+    getInstance().m_watchTimer = g_timeout_add(SAMConf::getInstance().getAppWatchDelay(), onWatchTimeout, nullptr);
+    return G_SOURCE_CONTINUE;
+}
+
+gboolean AppDescriptionList::onWatchTimeout(gpointer data)
+{
+    set<string> appIds;
+    appIds.swap(getInstance().m_changedAppIds);
+    getInstance().m_watchTimer = 0;
+
+    for (const string& appId : appIds) {
+        Logger::info(getInstance().getClassName(), __FUNCTION__, appId, "Rescan changed app");
+        getInstance().rescanApp(appId, true);
+    }
+    AppDescriptionCache::getInstance().scheduleSave();
+    return G_SOURCE_REMOVE;
+}
+
+void AppDescriptionList::addWatch(const string& path, const string& appId)
+{
+    uint32_t mask = IN_ONLYDIR | IN_CREATE | IN_DELETE | IN_MOVED_TO | IN_MOVED_FROM;
+    if (!appId.empty())
+        mask |= IN_CLOSE_WRITE;
+
+    int wd = inotify_add_watch(m_inotifyFd, path.c_str(), mask);
+    if (wd < 0) {
+        Logger::warning(getClassName(), __FUNCTION__, Logger::format("Failed to watch %s: %s", path.c_str(), strerror(errno)));
+        return;
+    }
+    m_watches[wd] = make_pair(path, appId);
+}
+
+void AppDescriptionList::onWatchEvent(int wd, uint32_t mask, const string& name)
+{
+    if (mask & IN_Q_OVERFLOW) {
+        // Some events are lost. Check all known apps and all app folders.
+        Logger::warning(getClassName(), __FUNCTION__, "Event queue overflowed. Rescan all apps");
+        for (const auto& appDesc : m_map) {
+            m_changedAppIds.insert(appDesc.first);
+        }
+        for (const auto& watch : m_watches) {
+            if (!watch.second.second.empty())
+                m_changedAppIds.insert(watch.second.second);
+        }
+        return;
+    }
+
+    auto it = m_watches.find(wd);
+    if (it == m_watches.end())
+        return;
+
+    if (mask & IN_IGNORED) {
+        // watched directory is removed
+        m_watches.erase(it);
+        return;
+    }
+    if (name.empty() || name[0] == '.')
+        return;
+
+    const string& path = it->second.first;
+    const string& appId = it->second.second;
+    if (!appId.empty()) {
+        // Only appinfo.json decides AppDescription. Other files (icons, etc) don't need to rescan.
+        if (name == "appinfo.json" && !SAMConf::getInstance().isDeletedSystemApp(appId))
+            m_changedAppIds.insert(appId);
+        return;
+    }
+
+    if (SAMConf::getInstance().isBlockedApp(name) || SAMConf::getInstance().isDeletedSystemApp(name))
+        return;
+    if ((mask & IN_ISDIR) && (mask & (IN_CREATE | IN_MOVED_TO)))
+        addWatch(File::join(path, name), name);
+    m_changedAppIds.insert(name);
+}
+
+void AppDescriptionList::onScanJob(gpointer data, gpointer userData)
+{
+    ScanJob* job = static_cast<ScanJob*>(data);
+    job->m_tid = BootTimeline::getThreadId();
+    job->m_startTime = Time::getCurrentTimeUs();
+    job->m_isScanned = job->m_appDesc->scan(job->m_folderPath, job->m_appLocation);
+    job->m_endTime = Time::getCurrentTimeUs();
+}
+
+void AppDescriptionList::collectDir(const string& path, const AppLocation& appLocation, vector<ScanJob>& jobs)
 {
     dirent** entries = NULL;
     int entryCount = ::scandir(path.c_str(), &entries, 0, alphasort);
@@ -187,12 +398,16 @@ void AppDescriptionList::scanDir(const string& path, const AppLocation& appLocat
             Logger::warning(getClassName(), __FUNCTION__, entries[i]->d_name, "Cannot create application description");
             continue;
         }
-        if (!appDesc->scan(folderPath, appLocation)) {
-            Logger::warning(getClassName(), __FUNCTION__, entries[i]->d_name, "Cannot scan AppDescription");
-            continue;
-        }
-        AppDescriptionList::getInstance().add(std::move(appDesc));
 
+        ScanJob job;
+        job.m_appDesc = std::move(appDesc);
+        job.m_folderPath = folderPath;
+        job.m_appLocation = appLocation;
+        job.m_isScanned = false;
+        job.m_startTime = 0;
+        job.m_endTime = 0;
+        job.m_tid = 0;
+        jobs.push_back(std::move(job));
     }
 
 Done:
@@ -207,6 +422,48 @@ Done:
     return;
 }
 
+void AppDescriptionList::runScanJobs(vector<ScanJob>& jobs)
+{
+    int threadCount = SAMConf::getInstance().getScanThreadCount();
+    GThreadPool* pool = nullptr;
+
+    if (threadCount > 1 && jobs.size() > 1) {
+        // Workers only read shared data. Compile schema here to avoid filling the schema cache in workers.
+        JValueUtil::getSchema("ApplicationDescription");
+
+        GError* error = NULL;
+        pool = g_thread_pool_new(onScanJob, nullptr, threadCount, TRUE, &error);
+        if (pool == nullptr) {
+            Logger::warning(getClassName(), __FUNCTION__, Logger::format("Failed to create thread pool: %s", error ? error->message : ""));
+            if (error)
+                g_error_free(error);
+        }
+    }
+
+    if (pool) {
+        Logger::info(getClassName(), __FUNCTION__, Logger::format("Scan %d apps with %d threads", (int) jobs.size(), threadCount));
+        for (auto& job : jobs) {
+            g_thread_pool_push(pool, &job, NULL);
+        }
+        // wait until all jobs are done
+        g_thread_pool_free(pool, FALSE, TRUE);
+    } else {
+        for (auto& job : jobs) {
+            onScanJob(&job, nullptr);
+        }
+    }
+
+    // Merge in the same order as serial scan. So AppDescriptionList::compare decides winner in the same way.
+    for (auto& job : jobs) {
+        BootTimeline::getInstance().addDuration(job.m_appDesc->getAppId(), "scan", job.m_startTime, job.m_endTime, job.m_tid);
+        if (!job.m_isScanned) {
+            Logger::warning(getClassName(), __FUNCTION__, job.m_appDesc->getAppId(), "Cannot scan AppDescription");
+            continue;
+        }
+        AppDescriptionList::getInstance().add(std::move(job.m_appDesc));
+    }
+}
+
 AppDescriptionPtr AppDescriptionList::create(const string& appId)
 {
     if (appId.empty()) {
@@ -239,6 +496,7 @@ bool AppDescriptionList::add(AppDescriptionPtr newAppDesc)
     if (m_map.find(newAppDesc->getAppId()) == m_map.end()) {
         Logger::info(getClassName(), __FUNCTION__, newAppDesc->getAppId() + " is added");
         m_map[newAppDesc->getAppId()] = newAppDesc;
+        onChanged();
         ApplicationManager::getInstance().postListApps(newAppDesc, "added", "");
         LaunchPointPtr launchPoint = LaunchPointList::getInstance().createDefault(newAppDesc);
         LaunchPointList::getInstance().add(std::move(launchPoint));
@@ -249,6 +507,7 @@ bool AppDescriptionList::add(AppDescriptionPtr newAppDesc)
         // same directory means *update*
         AppDescriptionPtr oldAppDesc = m_map[newAppDesc->getAppId()];
         m_map[newAppDesc->getAppId()] = newAppDesc;
+        onChanged();
         ApplicationManager::getInstance().postListApps(newAppDesc, "updated", "");
         LaunchPointList::getInstance().update(std::move(oldAppDesc), newAppDesc);
     } else if (compare(m_map[newAppDesc->getAppId()], newAppDesc) || !m_map[newAppDesc->getAppId()]->scan()) {
@@ -256,17 +515,22 @@ bool AppDescriptionList::add(AppDescriptionPtr newAppDesc)
         // check version of new app description.
         AppDescriptionPtr oldAppDesc = m_map[newAppDesc->getAppId()];
         m_map[newAppDesc->getAppId()] = newAppDesc;
+        onChanged();
         ApplicationManager::getInstance().postListApps(newAppDesc, "updated", "");
         LaunchPointList::getInstance().update(std::move(oldAppDesc), newAppDesc);
+    } else {
+        // existing one is rescanned in place by above condition
+        onChanged();
+        LaunchPointList::getInstance().reindexByAppId(newAppDesc->getAppId());
     }
     return true;
 }
 
-void AppDescriptionList::removeByAppId(const string& appId)
+void AppDescriptionList::removeByAppId(const string& appId, bool isUninstalled)
 {
     for (auto it = m_map.begin(); it != m_map.end(); ++it) {
         if ((*it).second->getAppId() == appId) {
-            onRemove((*it).second);
+            onRemove((*it).second, isUninstalled);
             m_map.erase(it);
             return;
         }
@@ -308,9 +572,36 @@ void AppDescriptionList::toJson(JValue& json, JValue& properties, bool devmode)
     }
 }
 
-void AppDescriptionList::onRemove(AppDescriptionPtr appDesc)
+const string& AppDescriptionList::toSerializedJson(const AppDescription::Projection& projection, bool devmode)
+{
+    string key = (devmode ? "D" : "N") + projection.getKey();
+    auto it = m_serializedApps.find(key);
+    if (it != m_serializedApps.end())
+        return it->second;
+
+    string& serialized = m_serializedApps[key];
+    serialized = "[";
+    for (const auto& appDesc : m_map) {
+        if (devmode && appDesc.second->getAppLocation() != AppLocation::AppLocation_Devmode) continue;
+
+        if (serialized.length() > 1)
+            serialized += ",";
+        appDesc.second->toProjectedJson(projection, serialized);
+    }
+    serialized += "]";
+    return serialized;
+}
+
+void AppDescriptionList::onChanged()
+{
+    m_version++;
+    m_serializedApps.clear();
+}
+
+void AppDescriptionList::onRemove(AppDescriptionPtr appDesc, bool isUninstalled)
 {
-    if (appDesc->isSystemApp()) {
+    onChanged();
+    if (isUninstalled && appDesc->isSystemApp()) {
         Logger::info(getClassName(), __FUNCTION__, appDesc->getAppId(), "remove system-app in read-write area");
         SAMConf::getInstance().appendDeletedSystemApp(appDesc->getAppId());
     }
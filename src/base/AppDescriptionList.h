@@ -20,6 +20,9 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <set>
+#include <vector>
+#include <glib.h>
 
 #include "AppDescription.h"
 #include "interface/IClassName.h"
@@ -41,22 +44,69 @@ public:
     void scanFull();
     void scanDir(const string& path, const AppLocation& appLocation);
 
+    void startWatch();
+    void stopWatch();
+
     AppDescriptionPtr create(const string& appId);
     AppDescriptionPtr getByAppId(const string& appId);
 
     bool add(AppDescriptionPtr appDesc);
-    void removeByAppId(const string& appId);
+    // System app is recorded as deleted only if it is uninstalled
+    void removeByAppId(const string& appId, bool isUninstalled = true);
     void removeByObject(AppDescriptionPtr appDesc);
 
     bool isExist(const string& appId);
     void toJson(JValue& json, JValue& properties, bool devmode = false);
 
+    // Returns serialized 'apps' array. It is cached until the list is changed.
+    const string& toSerializedJson(const AppDescription::Projection& projection, bool devmode = false);
+
+    unsigned long getVersion() const
+    {
+        return m_version;
+    }
+
 private:
+    struct ScanJob {
+        AppDescriptionPtr m_appDesc;
+        string m_folderPath;
+        AppLocation m_appLocation;
+        bool m_isScanned;
+        // for BootTimeline
+        long long m_startTime;
+        long long m_endTime;
+        int m_tid;
+    };
+
+    static void onScanJob(gpointer data, gpointer userData);
+    static gboolean onAppDirChanged(gint fd, GIOCondition condition, gpointer data);
+    static gboolean onWatchTimeout(gpointer data);
+
     AppDescriptionList();
 
-    void onRemove(AppDescriptionPtr appDesc);
+    void collectDir(const string& path, const AppLocation& appLocation, vector<ScanJob>& jobs);
+    void runScanJobs(vector<ScanJob>& jobs);
+
+    // Watcher doesn't remove the app unless its folder is gone from all ApplicationPaths
+    void rescanApp(const string& appId, bool isWatchEvent = false);
+    void addWatch(const string& path, const string& appId = "");
+    void onWatchEvent(int wd, uint32_t mask, const string& name);
+
+    void onRemove(AppDescriptionPtr appDesc, bool isUninstalled = true);
+    void onChanged();
 
     map<string, AppDescriptionPtr> m_map;
+
+    // (devmode, projection key) => serialized 'apps' array
+    map<string, string> m_serializedApps;
+    unsigned long m_version;
+
+    // watch descriptor => (watched path, appId). appId is empty if the path is one of ApplicationPaths
+    map<int, pair<string, string>> m_watches;
+    set<string> m_changedAppIds;
+    int m_inotifyFd;
+    guint m_inotifySource;
+    guint m_watchTimer;
 };
 
 #endif /* BASE_APPDESCRIPTIONLIST_H_ */
@@ -0,0 +1,135 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "base/BootTimeline.h"
+
+#include <unistd.h>
+#include <sys/syscall.h>
+
+#include "conf/SAMConf.h"
+#include "util/File.h"
+#include "util/JsonWriter.h"
+#include "util/Logger.h"
+
+int BootTimeline::getThreadId()
+{
+    return (int) syscall(SYS_gettid);
+}
+
+BootTimeline::BootTimeline()
+    : m_pid(getpid())
+{
+    setClassName("BootTimeline");
+}
+
+BootTimeline::~BootTimeline()
+{
+}
+
+void BootTimeline::addDuration(const string& name, const char* category, long long startUs, long long endUs, int tid)
+{
+    if (isFull())
+        return;
+
+    Event event;
+    event.m_name = name;
+    event.m_category = category;
+    event.m_phase = 'X';
+    event.m_timestamp = startUs;
+    event.m_duration = endUs - startUs;
+    event.m_tid = (tid == 0) ? m_pid : tid;
+    m_events.push_back(std::move(event));
+}
+
+void BootTimeline::addInstant(const string& name, const char* category)
+{
+    if (isFull())
+        return;
+
+    Event event;
+    event.m_name = name;
+    event.m_category = category;
+    event.m_phase = 'i';
+    event.m_timestamp = Time::getCurrentTimeUs();
+    event.m_duration = 0;
+    event.m_tid = m_pid;
+    m_events.push_back(std::move(event));
+}
+
+void BootTimeline::addFirst(const string& name, const char* category)
+{
+    if (isFull())
+        return;
+    if (!m_firsts.insert(name).second)
+        return;
+    addInstant(name, category);
+}
+
+void BootTimeline::toTraceJson(string& buffer)
+{
+    buffer = "{\"traceEvents\":";
+    toTraceEventsJson(buffer);
+    buffer += ",\"displayTimeUnit\":\"ms\"}";
+}
+
+void BootTimeline::toTraceEventsJson(string& buffer)
+{
+    JsonWriter writer(buffer);
+    writer.beginArray();
+    writer.beginObject()
+          .field("name", "process_name")
+          .field("ph", "M")
+          .field("pid", (int) m_pid)
+          .key("args").beginObject().field("name", "sam").endObject()
+          .endObject();
+    for (const Event& event : m_events) {
+        char phase[2] = { event.m_phase, '\0' };
+        writer.beginObject()
+              .field("name", event.m_name)
+              .field("cat", event.m_category)
+              .field("ph", (const char*) phase)
+              .field("ts", event.m_timestamp);
+        if (event.m_phase == 'X')
+            writer.field("dur", event.m_duration);
+        else
+            writer.field("s", "p");
+        writer.field("pid", (int) m_pid)
+              .field("tid", event.m_tid)
+              .endObject();
+    }
+    writer.endArray();
+}
+
+void BootTimeline::dump()
+{
+    const string& path = SAMConf::getInstance().getBootTimelinePath();
+    if (path.empty())
+        return;
+
+    string buffer;
+    toTraceJson(buffer);
+    if (!File::writeFileAtomically(path, buffer)) {
+        Logger::warning(getClassName(), __FUNCTION__, Logger::format("Failed to write %s", path.c_str()));
+        return;
+    }
+    Logger::info(getClassName(), __FUNCTION__, Logger::format("%d events are written in %s", (int) m_events.size(), path.c_str()));
+}
+
+bool BootTimeline::isFull()
+{
+    return m_events.size() >= MAX_EVENTS;
+}
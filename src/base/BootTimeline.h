@@ -0,0 +1,77 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef BASE_BOOTTIMELINE_H_
+#define BASE_BOOTTIMELINE_H_
+
+#include <iostream>
+#include <set>
+#include <vector>
+#include <sys/types.h>
+
+#include "interface/IClassName.h"
+#include "interface/ISingleton.h"
+#include "util/Time.h"
+
+using namespace std;
+
+// Records boot phases of SAM and exports them in Chrome trace-event format.
+// Timestamps are monotonic microseconds. All events should be added in main thread.
+class BootTimeline : public ISingleton<BootTimeline>,
+                     public IClassName {
+friend class ISingleton<BootTimeline>;
+public:
+    static const int MAX_EVENTS = 4096;
+
+    static int getThreadId();
+
+    virtual ~BootTimeline();
+
+    // complete event ("ph":"X"). tid 0 means main thread
+    void addDuration(const string& name, const char* category, long long startUs, long long endUs = Time::getCurrentTimeUs(), int tid = 0);
+    // instant event ("ph":"i")
+    void addInstant(const string& name, const char* category);
+    // instant event which is recorded only for the first call of each name
+    void addFirst(const string& name, const char* category);
+
+    // {"traceEvents":[...]} which can be loaded in chrome://tracing or Perfetto
+    void toTraceJson(string& buffer);
+    // only events array
+    void toTraceEventsJson(string& buffer);
+    // writes trace JSON into 'BootTimelinePath' if it is configured
+    void dump();
+
+private:
+    struct Event {
+        string m_name;
+        const char* m_category;
+        char m_phase;
+        long long m_timestamp;
+        long long m_duration;
+        int m_tid;
+    };
+
+    BootTimeline();
+
+    bool isFull();
+
+    vector<Event> m_events;
+    set<string> m_firsts;
+    pid_t m_pid;
+};
+
+#endif /* BASE_BOOTTIMELINE_H_ */
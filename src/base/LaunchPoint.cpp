@@ -15,6 +15,8 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "base/LaunchPoint.h"
+#include "base/LaunchPointList.h"
+#include "base/RunningAppList.h"
 #include "bus/client/DB8.h"
 #include "util/JValueUtil.h"
 
@@ -56,6 +58,15 @@ LaunchPoint::~LaunchPoint()
 {
 }
 
+void LaunchPoint::setAppDesc(AppDescriptionPtr appDesc)
+{
+    m_appDesc = std::move(appDesc);
+    invalidateJson();
+    LaunchPointList::getInstance().reindex(*this);
+    // Running instances cache fields of old AppDescription
+    RunningAppList::getInstance().reindexByLaunchPoint(*this);
+}
+
 void LaunchPoint::syncDatabase()
 {
     if (m_isDirty == false) {
@@ -85,6 +96,8 @@ void LaunchPoint::setDatabase(const JValue& database)
 {
     // This method should be called by DB8 instance
     m_database = database.duplicate();
+    invalidateJson();
+    LaunchPointList::getInstance().reindex(*this);
 }
 
 void LaunchPoint::updateDatabase(const JValue& json)
@@ -103,9 +116,30 @@ void LaunchPoint::updateDatabase(const JValue& json)
             m_isDirty = true;
         }
     }
+    invalidateJson();
+    LaunchPointList::getInstance().reindex(*this);
+}
+
+const JValue& LaunchPoint::getJson()
+{
+    if (m_json.isNull())
+        makeJson(m_json);
+    return m_json;
+}
+
+const string& LaunchPoint::getSerializedJson()
+{
+    if (m_serializedJson.empty())
+        m_serializedJson = getJson().stringify();
+    return m_serializedJson;
+}
+
+void LaunchPoint::toJson(JValue& json)
+{
+    json = getJson().duplicate();
 }
 
-void LaunchPoint::toJson(JValue& json) const
+void LaunchPoint::makeJson(JValue& json) const
 {
     m_appDesc->toJson(json);
     for (JValue::KeyValue obj : m_database.children()) {
@@ -62,16 +62,14 @@ public:
     void setType(const LaunchPointType type)
     {
         m_type = type;
+        invalidateJson();
     }
 
     AppDescriptionPtr getAppDesc() const
     {
         return m_appDesc;
     }
-    void setAppDesc(AppDescriptionPtr appDesc)
-    {
-        m_appDesc = std::move(appDesc);
-    }
+    void setAppDesc(AppDescriptionPtr appDesc);
 
     const string getAppId() const
     {
@@ -193,12 +191,23 @@ public:
         return m_appDesc->isVisible();
     }
 
-    void toJson(JValue& json) const;
+    // Merged view of AppDescription and database. It is cached until appDesc or database is changed.
+    const JValue& getJson();
+    const string& getSerializedJson();
+    void invalidateJson()
+    {
+        m_json = JValue();
+        m_serializedJson.clear();
+    }
+
+    void toJson(JValue& json);
 
 private:
     LaunchPoint(const LaunchPoint&);
     LaunchPoint& operator=(const LaunchPoint&) const;
 
+    void makeJson(JValue& json) const;
+
     LaunchPointType m_type;
     AppDescriptionPtr m_appDesc;
     string m_launchPointId;
@@ -206,6 +215,9 @@ private:
     bool m_isDirty;
     JValue m_database;
 
+    JValue m_json;
+    string m_serializedJson;
+
 };
 
 #endif /* LAUNCH_POINT_H */
@@ -37,11 +37,18 @@ LaunchPointList::~LaunchPointList()
 void LaunchPointList::clear()
 {
     m_list.clear();
+    m_idIndex.clear();
+    m_appIdIndex.clear();
+    m_titleIndex.clear();
 }
 
 void LaunchPointList::sort()
 {
-    m_list.sort(LaunchPoint::compareTitle);
+    // m_titleIndex is already ordered by title. Just move list nodes along it.
+    m_serializedList.clear();
+    for (auto it = m_titleIndex.begin(); it != m_titleIndex.end(); ++it) {
+        m_list.splice(m_list.end(), m_list, m_idIndex[it->second->getLaunchPointId()].m_listIt);
+    }
 }
 
 LaunchPointPtr LaunchPointList::createBootmarkByAPI(AppDescriptionPtr appDesc, const JValue& database)
@@ -117,12 +124,10 @@ LaunchPointPtr LaunchPointList::getByLaunchPointId(const string& launchPointId)
     if (launchPointId.empty())
         return nullptr;
 
-    for (auto it = m_list.begin(); it != m_list.end(); ++it) {
-        if ((*it)->getLaunchPointId() == launchPointId) {
-            return *it;
-        }
-    }
-    return nullptr;
+    auto it = m_idIndex.find(launchPointId);
+    if (it == m_idIndex.end())
+        return nullptr;
+    return *(it->second.m_listIt);
 }
 
 bool LaunchPointList::add(LaunchPointPtr launchPoint)
@@ -142,19 +147,27 @@ bool LaunchPointList::add(LaunchPointPtr launchPoint)
 
 bool LaunchPointList::remove(LaunchPointPtr launchPoint)
 {
-    for (auto it = m_list.begin(); it != m_list.end(); ++it) {
-        if ((*it) == launchPoint) {
-            m_list.erase(it);
-            onRemove(launchPoint);
-            return true;
-        }
-    }
+    if (launchPoint == nullptr)
+        return true;
+
+    auto it = m_idIndex.find(launchPoint->getLaunchPointId());
+    if (it == m_idIndex.end() || *(it->second.m_listIt) != launchPoint)
+        return true;
+
+    erase(it->second.m_listIt);
+    onRemove(std::move(launchPoint));
     return true;
 }
 
 bool LaunchPointList::update(AppDescriptionPtr oldAppDesc, AppDescriptionPtr newAppDesc)
 {
-    for (auto it = m_list.begin(); it != m_list.end(); ++it) {
+    auto index = m_appIdIndex.find(oldAppDesc->getAppId());
+    if (index == m_appIdIndex.end())
+        return true;
+
+    // setAppDesc() reindexes launchPoint. So iterate over a copy.
+    list<LaunchPointPtr> launchPoints = index->second;
+    for (auto it = launchPoints.begin(); it != launchPoints.end(); ++it) {
         if ((*it)->getAppDesc() == oldAppDesc) {
             (*it)->setAppDesc(newAppDesc);
             onUpdate(*it);
@@ -165,40 +178,45 @@ bool LaunchPointList::update(AppDescriptionPtr oldAppDesc, AppDescriptionPtr new
 
 void LaunchPointList::removeByAppDesc(AppDescriptionPtr appDesc)
 {
-    for (auto it = m_list.begin(); it != m_list.end();) {
-        if ((*it)->getAppDesc() == appDesc) {
-            LaunchPointPtr launchPoint = *it;
-            it = m_list.erase(it);
-            onRemove(std::move(launchPoint));
-        } else {
-            ++it;
-        }
+    auto index = m_appIdIndex.find(appDesc->getAppId());
+    if (index == m_appIdIndex.end())
+        return;
+
+    list<LaunchPointPtr> launchPoints = index->second;
+    for (auto it = launchPoints.begin(); it != launchPoints.end(); ++it) {
+        if ((*it)->getAppDesc() != appDesc || !isExist((*it)->getLaunchPointId()))
+            continue;
+
+        erase(m_idIndex[(*it)->getLaunchPointId()].m_listIt);
+        onRemove(*it);
     }
 }
 
 void LaunchPointList::removeByAppId(const string& appId)
 {
-    for (auto it = m_list.begin(); it != m_list.end();) {
-        if ((*it)->getAppDesc()->getAppId() == appId) {
-            LaunchPointPtr launchPoint = *it;
-            it = m_list.erase(it);
-            onRemove(std::move(launchPoint));
-        } else {
-            ++it;
-        }
+    auto index = m_appIdIndex.find(appId);
+    if (index == m_appIdIndex.end())
+        return;
+
+    list<LaunchPointPtr> launchPoints = index->second;
+    for (auto it = launchPoints.begin(); it != launchPoints.end(); ++it) {
+        if (!isExist((*it)->getLaunchPointId()))
+            continue;
+
+        erase(m_idIndex[(*it)->getLaunchPointId()].m_listIt);
+        onRemove(*it);
     }
 }
 
 void LaunchPointList::removeByLaunchPointId(const string& launchPointId)
 {
-    for (auto it = m_list.begin(); it != m_list.end(); ++it) {
-        if ((*it)->getLaunchPointId() == launchPointId) {
-            LaunchPointPtr launchPoint = *it;
-            it = m_list.erase(it);
-            onRemove(std::move(launchPoint));
-            return;
-        }
-    }
+    auto it = m_idIndex.find(launchPointId);
+    if (it == m_idIndex.end())
+        return;
+
+    LaunchPointPtr launchPoint = *(it->second.m_listIt);
+    erase(it->second.m_listIt);
+    onRemove(std::move(launchPoint));
 }
 
 bool LaunchPointList::isExist(const string& launchPointId)
@@ -206,11 +224,7 @@ bool LaunchPointList::isExist(const string& launchPointId)
     if (launchPointId.empty())
         return false;
 
-    for (auto it = m_list.begin(); it != m_list.end(); ++it) {
-        if ((*it)->getLaunchPointId() == launchPointId)
-            return true;
-    }
-    return false;
+    return m_idIndex.find(launchPointId) != m_idIndex.end();
 }
 
 void LaunchPointList::toJson(JValue& json)
@@ -221,13 +235,28 @@ void LaunchPointList::toJson(JValue& json)
 
     for (auto it = m_list.begin(); it != m_list.end(); ++it) {
         if ((*it)->isVisible()) {
-            JValue item;
-            (*it)->toJson(item);
-            json.append(item);
+            json.append((*it)->getJson());
         }
     }
 }
 
+const string& LaunchPointList::toSerializedJson()
+{
+    if (!m_serializedList.empty())
+        return m_serializedList;
+
+    m_serializedList = "[";
+    for (auto it = m_list.begin(); it != m_list.end(); ++it) {
+        if (!(*it)->isVisible())
+            continue;
+        if (m_serializedList.length() > 1)
+            m_serializedList += ",";
+        m_serializedList += (*it)->getSerializedJson();
+    }
+    m_serializedList += "]";
+    return m_serializedList;
+}
+
 string LaunchPointList::generateLaunchPointId(LaunchPointType type, const string& appId)
 {
     if (type == LaunchPointType::LaunchPoint_DEFAULT) {
@@ -241,18 +270,60 @@ string LaunchPointList::generateLaunchPointId(LaunchPointType type, const string
         double verifier = tv.tv_usec;
 
         launchPointId = appId + "_" + boost::lexical_cast<string>(verifier);
-        if (LaunchPointList::getInstance().getByLaunchPointId(launchPointId) == nullptr)
+        if (!LaunchPointList::getInstance().isExist(launchPointId))
             break;
     }
 
     return launchPointId;
 }
 
+void LaunchPointList::reindex(LaunchPoint& launchPoint)
+{
+    auto it = m_idIndex.find(launchPoint.getLaunchPointId());
+    if (it == m_idIndex.end() || it->second.m_listIt->get() != &launchPoint)
+        return;
+
+    // appDesc can be rescanned in place. (See AppDescriptionList::changeLocale)
+    launchPoint.invalidateJson();
+    m_serializedList.clear();
+
+    Index& index = it->second;
+    const LaunchPointPtr& ptr = *(index.m_listIt);
+    m_titleIndex.erase(index.m_titleIt);
+    index.m_titleIt = m_titleIndex.insert(make_pair(launchPoint.getTitle(), ptr));
+
+    if (index.m_appId != launchPoint.getAppId()) {
+        auto appIdIt = m_appIdIndex.find(index.m_appId);
+        if (appIdIt != m_appIdIndex.end()) {
+            appIdIt->second.remove(ptr);
+            if (appIdIt->second.empty())
+                m_appIdIndex.erase(appIdIt);
+        }
+        index.m_appId = launchPoint.getAppId();
+        m_appIdIndex[index.m_appId].push_back(ptr);
+    }
+}
+
+void LaunchPointList::reindexByAppId(const string& appId)
+{
+    auto index = m_appIdIndex.find(appId);
+    if (index == m_appIdIndex.end())
+        return;
+
+    list<LaunchPointPtr> launchPoints = index->second;
+    for (auto it = launchPoints.begin(); it != launchPoints.end(); ++it) {
+        reindex(**it);
+        // AppDescription is rescanned in place
+        RunningAppList::getInstance().reindexByLaunchPoint(**it);
+    }
+}
+
 void LaunchPointList::onAdd(LaunchPointPtr launchPoint)
 {
     Logger::info(getClassName(), __FUNCTION__, launchPoint->getLaunchPointId() + " is added");
     launchPoint->syncDatabase();
     m_list.push_back(launchPoint);
+    addIndexes(--m_list.end());
     ApplicationManager::getInstance().postListLaunchPoints(std::move(launchPoint), "added");
 }
 
@@ -269,3 +340,38 @@ void LaunchPointList::onRemove(LaunchPointPtr launchPoint)
     DB8::getInstance().deleteLaunchPoint(launchPoint->getLaunchPointId());
     ApplicationManager::getInstance().postListLaunchPoints(std::move(launchPoint), "removed");
 }
+
+void LaunchPointList::addIndexes(list<LaunchPointPtr>::iterator it)
+{
+    m_serializedList.clear();
+
+    Index& index = m_idIndex[(*it)->getLaunchPointId()];
+    index.m_listIt = it;
+    index.m_titleIt = m_titleIndex.insert(make_pair((*it)->getTitle(), *it));
+    index.m_appId = (*it)->getAppId();
+    m_appIdIndex[index.m_appId].push_back(*it);
+}
+
+void LaunchPointList::removeIndexes(const LaunchPointPtr& launchPoint)
+{
+    auto it = m_idIndex.find(launchPoint->getLaunchPointId());
+    if (it == m_idIndex.end())
+        return;
+
+    m_serializedList.clear();
+    m_titleIndex.erase(it->second.m_titleIt);
+
+    auto appIdIt = m_appIdIndex.find(it->second.m_appId);
+    if (appIdIt != m_appIdIndex.end()) {
+        appIdIt->second.remove(launchPoint);
+        if (appIdIt->second.empty())
+            m_appIdIndex.erase(appIdIt);
+    }
+    m_idIndex.erase(it);
+}
+
+list<LaunchPointPtr>::iterator LaunchPointList::erase(list<LaunchPointPtr>::iterator it)
+{
+    removeIndexes(*it);
+    return m_list.erase(it);
+}
@@ -19,6 +19,8 @@
 
 #include <iostream>
 #include <list>
+#include <map>
+#include <unordered_map>
 
 #include "base/LunaTask.h"
 #include "interface/ISingleton.h"
@@ -53,8 +55,20 @@ public:
 
     bool isExist(const string& launchPointId);
     void toJson(JValue& json);
+    // Returns serialized list of visible launch points. It is cached until the list or any item is changed.
+    const string& toSerializedJson();
+
+    // Should be called whenever title or appDesc of launchPoint is changed
+    void reindex(LaunchPoint& launchPoint);
+    void reindexByAppId(const string& appId);
 
 private:
+    struct Index {
+        list<LaunchPointPtr>::iterator m_listIt;
+        multimap<string, LaunchPointPtr>::iterator m_titleIt;
+        string m_appId;
+    };
+
     string generateLaunchPointId(LaunchPointType type, const string& appId);
 
     LaunchPointList();
@@ -63,7 +77,18 @@ private:
     void onUpdate(LaunchPointPtr launchPoint);
     void onRemove(LaunchPointPtr launchPoint);
 
+    void addIndexes(list<LaunchPointPtr>::iterator it);
+    void removeIndexes(const LaunchPointPtr& launchPoint);
+    list<LaunchPointPtr>::iterator erase(list<LaunchPointPtr>::iterator it);
+
     list<LaunchPointPtr> m_list;
+
+    unordered_map<string, Index> m_idIndex;
+    unordered_map<string, list<LaunchPointPtr>> m_appIdIndex;
+    multimap<string, LaunchPointPtr> m_titleIndex;
+
+    // empty string means 'not cached'
+    string m_serializedList;
 };
 
 #endif /* BASE_LAUNCHPOINTLIST_H_ */
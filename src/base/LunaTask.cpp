@@ -17,11 +17,30 @@
 #include "LunaTask.h"
 
 #include "AppDescriptionList.h"
+#include "LunaTaskList.h"
 #include "RunningAppList.h"
 #include "util/JValueUtil.h"
 
 #define LOG_NAME "LunaTask"
 
+void LunaTask::setInstanceId(const string& instanceId)
+{
+    m_instanceId = instanceId;
+    LunaTaskList::getInstance().reindex(*this);
+}
+
+void LunaTask::setToken(LSMessageToken token)
+{
+    m_token = token;
+    LunaTaskList::getInstance().reindex(*this);
+}
+
+void LunaTask::setTimeout(int timeout)
+{
+    m_timeout = timeout;
+    LunaTaskList::getInstance().reindex(*this);
+}
+
 int LunaTask::getDisplayId()
 {
     int displayId = -1;
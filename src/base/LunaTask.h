@@ -22,12 +22,15 @@
 #include <list>
 #include <boost/function.hpp>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <luna-service2/lunaservice.hpp>
 #include <pbnjson.hpp>
 
 #include "util/Logger.h"
 #include "util/JValueUtil.h"
+#include "util/JValueWriter.h"
 #include "util/Time.h"
 
 using namespace std;
@@ -52,7 +55,10 @@ public:
           m_responsePayload(pbnjson::Object()),
           m_errorCode(ErrCode_NOERROR),
           m_errorText(""),
-          m_reason("")
+          m_reason(""),
+          m_startTime(Time::getCurrentTime()),
+          m_startTimeNs(Time::getCurrentTimeNs()),
+          m_timeout(-1)
     {
         JValueUtil::getValue(m_requestPayload, "instanceId", m_instanceId);
         JValueUtil::getValue(m_requestPayload, "launchPointId", m_launchPointId);
@@ -68,10 +74,7 @@ public:
     {
         return m_instanceId;
     }
-    void setInstanceId(const string& instanceId)
-    {
-        m_instanceId = instanceId;
-    }
+    void setInstanceId(const string& instanceId);
 
     const string& getLaunchPointId() const
     {
@@ -114,10 +117,27 @@ public:
     {
         return m_token;
     }
-    void setToken(LSMessageToken token)
+    void setToken(LSMessageToken token);
+
+    long long getStartTime() const
+    {
+        return m_startTime;
+    }
+    long long getStartTimeUs() const
+    {
+        return m_startTimeNs / 1000;
+    }
+    long long getStartTimeNs() const
+    {
+        return m_startTimeNs;
+    }
+
+    // Reply is sent with error if the task is not finished within timeout(ms). 0 means no timeout
+    int getTimeout() const
     {
-        m_token = token;
+        return m_timeout;
     }
+    void setTimeout(int timeout);
 
     const JValue& getRequestPayload() const
     {
@@ -129,6 +149,12 @@ public:
         return m_responsePayload;
     }
 
+    // 'json' should be serialized JSON already. It is appended to response payload without parsing.
+    void putRawResponse(const string& key, const string& json)
+    {
+        m_rawResponses.push_back(make_pair(key, json));
+    }
+
     JValue getParams()
     {
         if (m_requestPayload.hasKey("params"))
@@ -241,18 +267,30 @@ public:
 
     void fillIds(JValue& json)
     {
-        json.put("instanceId", getInstanceId());
-        json.put("launchPointId", getLaunchPointId());
-        json.put("appId", getAppId());
-        if (getDisplayId() != -1)
-            json.put("displayId", getDisplayId());
+        JValueWriter writer(json);
+        writer.beginObject();
+        writeIds(writer);
+        writer.endObject();
+    }
+
+    // Writer is JsonWriter or JValueWriter
+    template <typename Writer>
+    void writeIds(Writer& writer)
+    {
+        writer.field("instanceId", getInstanceId())
+              .field("launchPointId", getLaunchPointId())
+              .field("appId", getAppId());
+        int displayId = getDisplayId();
+        if (displayId != -1)
+            writer.field("displayId", displayId);
     }
 
 private:
     LunaTask& operator=(const LunaTask& lunaTask) = delete;
     LunaTask(const LunaTask& lunaTask) = delete;
 
-    void reply()
+    // returns false if error reply is sent
+    bool reply()
     {
         bool returnValue = true;
         if (!m_errorText.empty() && !m_responsePayload.hasKey("errorText")) {
@@ -264,7 +302,19 @@ private:
             returnValue = false;
         }
         m_responsePayload.put("returnValue", returnValue);
-        m_request.respond(m_responsePayload.stringify().c_str());
+        if (m_rawResponses.empty() || !returnValue) {
+            m_request.respond(m_responsePayload.stringify().c_str());
+            return returnValue;
+        }
+
+        string payload = m_responsePayload.stringify();
+        payload.pop_back();
+        for (const auto& rawResponse : m_rawResponses) {
+            payload += ",\"" + rawResponse.first + "\":" + rawResponse.second;
+        }
+        payload += "}";
+        m_request.respond(payload.c_str());
+        return returnValue;
     }
 
     string m_instanceId;
@@ -276,6 +326,7 @@ private:
 
     JValue m_requestPayload;
     JValue m_responsePayload;
+    vector<pair<string, string>> m_rawResponses;
 
     int m_errorCode;
     string m_errorText;
@@ -286,6 +337,10 @@ private:
     LunaTaskCallback m_errorCallback;
 
     string m_nextStep;
+
+    long long m_startTime;
+    long long m_startTimeNs;
+    int m_timeout;
 };
 
 #endif  // BASE_LUNATASK_H_
@@ -18,12 +18,47 @@
 
 #include <string.h>
 
+#include "bus/service/APIMetrics.h"
+#include "conf/SAMConf.h"
+
+gboolean LunaTaskList::onSweep(gpointer context)
+{
+    LunaTaskList& self = getInstance();
+    long long now = Time::getCurrentTime();
+
+    while (!self.m_deadlines.empty() && self.m_deadlines.begin()->first <= now) {
+        LunaTaskPtr lunaTask = self.m_deadlines.begin()->second;
+        Logger::warning(self.getClassName(), __FUNCTION__, lunaTask->getId(),
+                        Logger::format("%s is timed out (%d ms)", lunaTask->getRequest().getKind(), lunaTask->getTimeout()));
+        self.m_expiredCount++;
+        lunaTask->setErrCodeAndText(ErrCode_GENERAL, "Request is timed out");
+        self.removeAfterReply(std::move(lunaTask), true);
+    }
+
+    if (self.m_deadlines.empty()) {
+        self.m_sweepTimer = 0;
+        return G_SOURCE_REMOVE;
+    }
+    return G_SOURCE_CONTINUE;
+}
+
 LunaTaskList::LunaTaskList()
+    : m_sweepTimer(0),
+      m_expiredCount(0)
 {
+    setClassName("LunaTaskList");
 }
 
 LunaTaskList::~LunaTaskList()
 {
+    if (m_sweepTimer != 0) {
+        g_source_remove(m_sweepTimer);
+        m_sweepTimer = 0;
+    }
+    m_deadlines.clear();
+    m_tokenIndex.clear();
+    m_instanceIdIndex.clear();
+    m_indexes.clear();
     m_list.clear();
 }
 
@@ -38,25 +73,27 @@ LunaTaskPtr LunaTaskList::getByKindAndId(const char* kind, const string& appId)
 
 LunaTaskPtr LunaTaskList::getByInstanceId(const string& instanceId)
 {
-    for (auto it = m_list.begin(); it != m_list.end(); ++it) {
-        if ((*it)->getInstanceId() == instanceId)
-            return *it;
-    }
-    return nullptr;
+    auto it = m_instanceIdIndex.find(instanceId);
+    if (it == m_instanceIdIndex.end() || it->second.empty())
+        return nullptr;
+    return it->second.front();
 }
 
 LunaTaskPtr LunaTaskList::getByToken(const LSMessageToken& token)
 {
-    for (auto it = m_list.begin(); it != m_list.end(); ++it) {
-        if ((*it)->getToken() == token)
-            return *it;
-    }
-    return nullptr;
+    auto it = m_tokenIndex.find(token);
+    if (it == m_tokenIndex.end() || it->second.empty())
+        return nullptr;
+    return it->second.front();
 }
 
 bool LunaTaskList::add(LunaTaskPtr lunaTask)
 {
+    if (lunaTask->m_timeout < 0)
+        lunaTask->m_timeout = SAMConf::getInstance().getLunaTaskTimeout();
+
     m_list.push_back(lunaTask);
+    addIndexes(--m_list.end());
     return true;
 }
 
@@ -64,17 +101,31 @@ void LunaTaskList::removeAfterReply(LunaTaskPtr lunaTask, bool fillIds)
 {
     if (lunaTask == nullptr) return;
 
-    for (auto it = m_list.begin(); it != m_list.end(); ++it) {
-        if ((*it) == lunaTask) {
-            if (fillIds) {
-                (*it)->fillIds((*it)->getResponsePayload());
-            }
-            (*it)->reply();
-            m_list.erase(it);
-            return;
-        }
+    auto it = m_indexes.find(lunaTask.get());
+    if (it == m_indexes.end())
+        return;
+
+    list<LunaTaskPtr>::iterator listIt = it->second.m_listIt;
+    if (fillIds) {
+        (*listIt)->fillIds((*listIt)->getResponsePayload());
     }
-    return;
+    bool isSuccess = (*listIt)->reply();
+    APIMetrics::getInstance().addEndToEndTime((*listIt)->getRequest().getKind(),
+                                              Time::getCurrentTimeUs() - (*listIt)->getStartTimeUs(),
+                                              isSuccess);
+    removeIndexes(*lunaTask);
+    m_list.erase(listIt);
+}
+
+void LunaTaskList::reindex(LunaTask& lunaTask)
+{
+    auto it = m_indexes.find(&lunaTask);
+    if (it == m_indexes.end())
+        return;
+
+    list<LunaTaskPtr>::iterator listIt = it->second.m_listIt;
+    removeIndexes(lunaTask);
+    addIndexes(listIt);
 }
 
 void LunaTaskList::toJson(JValue& array)
@@ -88,3 +139,79 @@ void LunaTaskList::toJson(JValue& array)
         array.append(object);
     }
 }
+
+void LunaTaskList::toStatJson(JValue& json)
+{
+    if (!json.isObject())
+        return;
+
+    // Tasks without timeout (ex. registered native apps) are not 'in-flight'
+    LunaTaskPtr oldest = nullptr;
+    int inFlight = 0;
+    for (auto it = m_list.begin(); it != m_list.end(); ++it) {
+        if ((*it)->getTimeout() == 0)
+            continue;
+        if (oldest == nullptr)
+            oldest = *it;
+        inFlight++;
+    }
+
+    json.put("depth", (int) m_list.size());
+    json.put("inFlight", inFlight);
+    json.put("expired", (int64_t) m_expiredCount);
+    if (oldest) {
+        JValue oldestJson = pbnjson::Object();
+        oldest->toAPIJson(oldestJson);
+        oldestJson.put("elapsed", (int64_t) (Time::getCurrentTime() - oldest->getStartTime()));
+        json.put("oldest", oldestJson);
+    }
+}
+
+void LunaTaskList::addIndexes(list<LunaTaskPtr>::iterator it)
+{
+    const LunaTaskPtr& lunaTask = *it;
+    Index& index = m_indexes[lunaTask.get()];
+    index.m_listIt = it;
+    index.m_token = lunaTask->getToken();
+    index.m_instanceId = lunaTask->getInstanceId();
+    index.m_hasDeadline = (lunaTask->getTimeout() > 0);
+
+    if (index.m_token != 0)
+        m_tokenIndex[index.m_token].push_back(lunaTask);
+    if (!index.m_instanceId.empty())
+        m_instanceIdIndex[index.m_instanceId].push_back(lunaTask);
+    if (index.m_hasDeadline) {
+        index.m_deadlineIt = m_deadlines.insert(make_pair(lunaTask->getStartTime() + lunaTask->getTimeout(), lunaTask));
+        if (m_sweepTimer == 0)
+            m_sweepTimer = g_timeout_add_seconds(1, onSweep, this);
+    }
+}
+
+void LunaTaskList::removeIndexes(LunaTask& lunaTask)
+{
+    auto it = m_indexes.find(&lunaTask);
+    if (it == m_indexes.end())
+        return;
+
+    Index& index = it->second;
+    const LunaTaskPtr& ptr = *(index.m_listIt);
+    if (index.m_token != 0) {
+        auto tokenIt = m_tokenIndex.find(index.m_token);
+        if (tokenIt != m_tokenIndex.end()) {
+            tokenIt->second.remove(ptr);
+            if (tokenIt->second.empty())
+                m_tokenIndex.erase(tokenIt);
+        }
+    }
+    if (!index.m_instanceId.empty()) {
+        auto instanceIdIt = m_instanceIdIndex.find(index.m_instanceId);
+        if (instanceIdIt != m_instanceIdIndex.end()) {
+            instanceIdIt->second.remove(ptr);
+            if (instanceIdIt->second.empty())
+                m_instanceIdIndex.erase(instanceIdIt);
+        }
+    }
+    if (index.m_hasDeadline)
+        m_deadlines.erase(index.m_deadlineIt);
+    m_indexes.erase(it);
+}
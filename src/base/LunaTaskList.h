@@ -19,13 +19,18 @@
 
 #include <iostream>
 #include <list>
+#include <map>
+#include <unordered_map>
+#include <glib.h>
 
+#include "interface/IClassName.h"
 #include "interface/ISingleton.h"
 #include "LunaTask.h"
 
 using namespace std;
 
-class LunaTaskList : public ISingleton<LunaTaskList> {
+class LunaTaskList : public ISingleton<LunaTaskList>,
+                     public IClassName {
 friend class ISingleton<LunaTaskList>;
 public:
     virtual ~LunaTaskList();
@@ -39,12 +44,37 @@ public:
     bool add(LunaTaskPtr lunaTask);
     void removeAfterReply(LunaTaskPtr lunaTask, bool fillIds = false);
 
+    // Should be called whenever token, instanceId or timeout of lunaTask is changed
+    void reindex(LunaTask& lunaTask);
+
     void toJson(JValue& array);
+    void toStatJson(JValue& json);
 
 private:
+    static gboolean onSweep(gpointer context);
+
+    struct Index {
+        list<LunaTaskPtr>::iterator m_listIt;
+        multimap<long long, LunaTaskPtr>::iterator m_deadlineIt;
+        bool m_hasDeadline;
+        LSMessageToken m_token;
+        string m_instanceId;
+    };
+
     LunaTaskList();
 
+    void addIndexes(list<LunaTaskPtr>::iterator it);
+    void removeIndexes(LunaTask& lunaTask);
+
     list<LunaTaskPtr> m_list;
+
+    unordered_map<LunaTask*, Index> m_indexes;
+    unordered_map<LSMessageToken, list<LunaTaskPtr>> m_tokenIndex;
+    unordered_map<string, list<LunaTaskPtr>> m_instanceIdIndex;
+    multimap<long long, LunaTaskPtr> m_deadlines;
+
+    guint m_sweepTimer;
+    long long m_expiredCount;
 };
 
 #endif /* BASE_LUNATASKLIST_H_ */
@@ -16,12 +16,45 @@
 
 #include "RunningApp.h"
 
+#include <algorithm>
+
+#include "base/RunningAppList.h"
 #include "bus/client/AbsLifeHandler.h"
+#include "bus/service/APIMetrics.h"
 #include "bus/service/ApplicationManager.h"
 #include "conf/SAMConf.h"
 
 const string RunningApp::CLASS_NAME = "RunningApp";
 
+const char* RunningApp::toString(LaunchPhase phase)
+{
+    switch (phase) {
+    case LaunchPhase::LaunchPhase_REQUEST:
+        return "request";
+
+    case LaunchPhase::LaunchPhase_CREATED:
+        return "created";
+
+    case LaunchPhase::LaunchPhase_MEMORY_REQUESTED:
+        return "memoryRequested";
+
+    case LaunchPhase::LaunchPhase_MEMORY_READY:
+        return "memoryReady";
+
+    case LaunchPhase::LaunchPhase_SPAWNING:
+        return "spawning";
+
+    case LaunchPhase::LaunchPhase_SPAWNED:
+        return "spawned";
+
+    case LaunchPhase::LaunchPhase_COMPLETED:
+        return "completed";
+
+    default:
+        return "unknown";
+    }
+}
+
 const char* RunningApp::toString(LifeStatus status)
 {
     switch (status) {
@@ -144,6 +177,8 @@ RunningApp::RunningApp(LaunchPointPtr launchPoint)
       m_isRegistered(false)
 {
     m_startTime = Time::getCurrentTime();
+    std::fill(m_launchPhaseTimes, m_launchPhaseTimes + static_cast<int>(LaunchPhase::LaunchPhase_COUNT), 0);
+    setLaunchPhaseTime(LaunchPhase::LaunchPhase_CREATED);
 }
 
 RunningApp::~RunningApp()
@@ -162,6 +197,8 @@ void RunningApp::registerApp(LunaTaskPtr lunaTask)
 
     m_registeredApp = lunaTask->getRequest();
     m_isRegistered = true;
+    // registerApp is replied whenever SAM sends events to the app
+    lunaTask->setTimeout(0);
 
     JValue payload = pbnjson::Object();
     payload.put("event", "registered");
@@ -189,6 +226,62 @@ bool RunningApp::sendEvent(JValue& responsePayload)
     return true;
 }
 
+void RunningApp::setLS2Name(const string& name)
+{
+    m_ls2name = name;
+    RunningAppList::getInstance().reindex(*this);
+}
+
+void RunningApp::setLaunchPoint(LaunchPointPtr launchPoint)
+{
+    m_launchPoint = std::move(launchPoint);
+    m_runningJson = JValue();
+    RunningAppList::getInstance().reindex(*this);
+}
+
+void RunningApp::setProcessId(pid_t pid)
+{
+    m_nativePocess.setPid(pid);
+    m_runningJson = JValue();
+    RunningAppList::getInstance().reindex(*this);
+}
+
+void RunningApp::setWebprocid(const string& webprocid)
+{
+    m_webprocessid = webprocid;
+    m_runningJson = JValue();
+    RunningAppList::getInstance().reindex(*this);
+}
+
+void RunningApp::setDisplayId(const int displayId)
+{
+    // TODO This is temp solution for support all platforms.
+    if (displayId < 0)
+        m_displayId = 0;
+    else
+        m_displayId = displayId;
+    m_runningJson = JValue();
+    RunningAppList::getInstance().reindex(*this);
+}
+
+void RunningApp::setToken(LSMessageToken token)
+{
+    m_token = token;
+    RunningAppList::getInstance().reindex(*this);
+}
+
+void RunningApp::toLaunchPhaseJson(JValue& json) const
+{
+    long long base = 0;
+    for (int i = 0; i < static_cast<int>(LaunchPhase::LaunchPhase_COUNT); ++i) {
+        if (m_launchPhaseTimes[i] == 0)
+            continue;
+        if (base == 0)
+            base = m_launchPhaseTimes[i];
+        json.put(toString(static_cast<LaunchPhase>(i)), (int64_t) (m_launchPhaseTimes[i] - base));
+    }
+}
+
 void RunningApp::setLifeStatus(LifeStatus lifeStatus)
 {
     if (m_lifeStatus == lifeStatus) {
@@ -203,11 +296,15 @@ void RunningApp::setLifeStatus(LifeStatus lifeStatus)
     }
 
     // First launching is completed
-    if (lifeStatus == LifeStatus::LifeStatus_FOREGROUND ||
-        lifeStatus == LifeStatus::LifeStatus_BACKGROUND ||
-        lifeStatus == LifeStatus::LifeStatus_PAUSED ||
-        lifeStatus == LifeStatus::LifeStatus_PRELOADED)
+    if (m_isFirstLaunch &&
+        (lifeStatus == LifeStatus::LifeStatus_FOREGROUND ||
+         lifeStatus == LifeStatus::LifeStatus_BACKGROUND ||
+         lifeStatus == LifeStatus::LifeStatus_PAUSED ||
+         lifeStatus == LifeStatus::LifeStatus_PRELOADED)) {
         m_isFirstLaunch = false;
+        setLaunchPhaseTime(LaunchPhase::LaunchPhase_COMPLETED);
+        APIMetrics::getInstance().addLaunchPhases(*this);
+    }
 
     switch (lifeStatus) {
     case LifeStatus::LifeStatus_STOP:
@@ -223,6 +320,7 @@ void RunningApp::setLifeStatus(LifeStatus lifeStatus)
             Logger::info(CLASS_NAME, __FUNCTION__, m_instanceId,
                          Logger::format("Changed: %s (%s ==> %s)", getAppId().c_str(), toString(m_lifeStatus), toString(LifeStatus::LifeStatus_RELAUNCHING)));
             m_lifeStatus = LifeStatus::LifeStatus_RELAUNCHING;
+            RunningAppList::getInstance().reindex(*this);
             ApplicationManager::getInstance().postGetAppLifeStatus(*this);
             lifeStatus = LifeStatus::LifeStatus_FOREGROUND;
         } else if (m_lifeStatus == LifeStatus::LifeStatus_BACKGROUND ||
@@ -239,6 +337,7 @@ void RunningApp::setLifeStatus(LifeStatus lifeStatus)
     Logger::info(CLASS_NAME, __FUNCTION__, m_instanceId,
                  Logger::format("Changed: %s (%s ==> %s)", getAppId().c_str(), toString(m_lifeStatus), toString(lifeStatus)));
     m_lifeStatus = lifeStatus;
+    RunningAppList::getInstance().reindex(*this);
 
     // Normally, transition should be completed within timeout sec
     // However, sometimes, it takes more than 10 seconds to launch the target app.
@@ -26,6 +26,7 @@
 #include "base/LunaTask.h"
 #include "base/LunaTaskList.h"
 #include "conf/SAMConf.h"
+#include "util/JValueWriter.h"
 #include "util/Logger.h"
 #include "util/Time.h"
 #include "util/NativeProcess.h"
@@ -57,10 +58,23 @@ enum class LifeStatus : int8_t {
     LifeStatus_CLOSING, // ==> STOP
 };
 
+// Steps of the first launch. Each step is stamped once with monotonic nanoseconds.
+enum class LaunchPhase : int8_t {
+    LaunchPhase_REQUEST, // 'launch' API is called
+    LaunchPhase_CREATED, // RunningApp is created
+    LaunchPhase_MEMORY_REQUESTED, // 'requireMemory' is sent to MemoryManager
+    LaunchPhase_MEMORY_READY, // MemoryManager replied
+    LaunchPhase_SPAWNING, // WAM or NativeContainer starts launching
+    LaunchPhase_SPAWNED, // WAM replied or the native process is forked
+    LaunchPhase_COMPLETED, // First FOREGROUND, BACKGROUND, PAUSED or PRELOADED
+    LaunchPhase_COUNT,
+};
+
 class RunningApp {
 friend class RunningAppList;
 public:
     static const char* toString(LifeStatus status);
+    static const char* toString(LaunchPhase phase);
     static bool isTransition(LifeStatus status);
     static string generateInstanceId(int displayId);
     static int getDisplayId(const string& instanceId);
@@ -89,6 +103,7 @@ public:
     }
     void setInstanceId(const string& instanceId)
     {
+        m_runningJson = JValue();
         if (instanceId.empty()) {
             // TODO WAM should support 'instanceId' for other platforms
             // SAM just consider 0 as displayId for default.
@@ -102,19 +117,13 @@ public:
     {
         return m_ls2name;
     }
-    void setLS2Name(const string& name)
-    {
-        m_ls2name = name;
-    }
+    void setLS2Name(const string& name);
 
     LaunchPointPtr getLaunchPoint() const
     {
         return m_launchPoint;
     }
-    void setLaunchPoint(LaunchPointPtr launchPoint)
-    {
-        m_launchPoint = std::move(launchPoint);
-    }
+    void setLaunchPoint(LaunchPointPtr launchPoint);
 
     const string& getWindowId() const
     {
@@ -129,14 +138,7 @@ public:
     {
         return m_displayId;
     }
-    void setDisplayId(const int displayId)
-    {
-        // TODO This is temp solution for support all platforms.
-        if (displayId < 0)
-            m_displayId = 0;
-        else
-            m_displayId = displayId;
-    }
+    void setDisplayId(const int displayId);
 
     bool isFullWindow() const
     {
@@ -151,19 +153,13 @@ public:
     {
         return m_nativePocess.getPid();
     }
-    void setProcessId(pid_t pid)
-    {
-        m_nativePocess.setPid(pid);
-    }
+    void setProcessId(pid_t pid);
 
     const string& getWebprocessid() const
     {
         return m_webprocessid;
     }
-    void setWebprocid(const string& webprocid)
-    {
-        m_webprocessid = webprocid;
-    }
+    void setWebprocid(const string& webprocid);
 
     bool isRegistered()
     {
@@ -237,6 +233,20 @@ public:
         return (now - m_startTime);
     }
 
+    // 0 means the phase is not reached (or skipped)
+    long long getLaunchPhaseTime(LaunchPhase phase) const
+    {
+        return m_launchPhaseTimes[static_cast<int>(phase)];
+    }
+    void setLaunchPhaseTime(LaunchPhase phase, long long ns = Time::getCurrentTimeNs())
+    {
+        long long& time = m_launchPhaseTimes[static_cast<int>(phase)];
+        if (time == 0)
+            time = ns;
+    }
+    // phase timestamps relative to the first reached phase (ns)
+    void toLaunchPhaseJson(JValue& json) const;
+
     const string& getReason() const
     {
         return m_reason;
@@ -250,10 +260,7 @@ public:
     {
         return m_token;
     }
-    void setToken(LSMessageToken token)
-    {
-        m_token = token;
-    }
+    void setToken(LSMessageToken token);
 
     int getContext() const
     {
@@ -279,32 +286,53 @@ public:
         json.put("reason", lunaTask->getReason());
     }
 
-    void toAPIJson(JValue& json, bool isRunningList)
+    // Item of 'running' list. It is cached until any field of it is changed.
+    const JValue& getRunningJson()
+    {
+        if (m_runningJson.isNull()) {
+            m_runningJson = pbnjson::Object();
+            JValueWriter writer(m_runningJson);
+            writer.beginObject();
+            writeAPIJson(writer, true);
+            writer.endObject();
+        }
+        return m_runningJson;
+    }
+
+    void invalidateRunningJson()
+    {
+        m_runningJson = JValue();
+    }
+
+    // Fields of 'running' item or getAppLifeStatus. Writer is JsonWriter or JValueWriter.
+    // Not null 'displayId' (e.g. foreground info from LSM) is written instead of own displayId.
+    template <typename Writer>
+    void writeAPIJson(Writer& writer, bool isRunningList, const JValue& displayId = JValue())
     {
-        json.put("instanceId", m_instanceId);
-        json.put("launchPointId", m_launchPoint->getLaunchPointId());
+        writer.field("instanceId", m_instanceId)
+              .field("launchPointId", m_launchPoint->getLaunchPointId());
 
-        if (m_displayId != -1)
-            json.put("displayId", m_displayId);
+        if (!displayId.isNull())
+            writer.field("displayId", displayId);
+        else if (m_displayId != -1)
+            writer.field("displayId", m_displayId);
 
         // processId should be 'string' for backward compatibilty
-        json.put("processid", std::to_string(m_nativePocess.getPid()));
-        json.put("webprocessid", m_webprocessid);
+        writer.field("processid", std::to_string(m_nativePocess.getPid()))
+              .field("webprocessid", m_webprocessid);
 
         if (isRunningList) {
-            json.put("id", m_launchPoint->getAppId());
-            json.put("defaultWindowType", m_launchPoint->getAppDesc()->getDefaultWindowType());
-            json.put("appType", AppDescription::toString(m_launchPoint->getAppDesc()->getAppType()));
+            writer.field("id", m_launchPoint->getAppId())
+                  .field("defaultWindowType", m_launchPoint->getAppDesc()->getDefaultWindowType())
+                  .field("appType", AppDescription::toString(m_launchPoint->getAppDesc()->getAppType()));
         } else {
-            json.put("appId", m_launchPoint->getAppId());
-            json.put("status", toString(m_lifeStatus));
-            json.put("reason", m_reason);
-            json.put("type", AppDescription::toString(m_launchPoint->getAppDesc()->getAppType()));
+            writer.field("appId", m_launchPoint->getAppId())
+                  .field("status", toString(m_lifeStatus))
+                  .field("reason", m_reason)
+                  .field("type", AppDescription::toString(m_launchPoint->getAppDesc()->getAppType()));
         }
     }
 
-
-
 private:
     static const string CLASS_NAME;
     static const int TIMEOUT_CLOSE = 1000; // 1 second
@@ -329,6 +357,7 @@ private:
     LifeStatus m_lifeStatus;
     bool m_isFirstLaunch;
     long long m_startTime;
+    long long m_launchPhaseTimes[static_cast<int>(LaunchPhase::LaunchPhase_COUNT)];
     guint m_killingTimer;
 
     // initial parameter
@@ -348,6 +377,8 @@ private:
     bool m_isRegistered;
     LS::Message m_registeredApp;
 
+    JValue m_runningJson;
+
 };
 
 typedef shared_ptr<RunningApp> RunningAppPtr;
@@ -20,6 +20,8 @@
 #include "conf/RuntimeInfo.h"
 
 RunningAppList::RunningAppList()
+    : m_transitionCount(0),
+      m_devmodeTransitionCount(0)
 {
     setClassName("RunningAppList");
 }
@@ -44,6 +46,7 @@ RunningAppPtr RunningAppList::createByLunaTask(LunaTaskPtr lunaTask)
         runningApp->loadRequestPayload(lunaTask->getRequestPayload());
         runningApp->setInstanceId(lunaTask->getInstanceId());
         runningApp->setDisplayId(lunaTask->getDisplayId());
+        runningApp->setLaunchPhaseTime(LaunchPhase::LaunchPhase_REQUEST, lunaTask->getStartTimeNs());
 
         lunaTask->setLaunchPointId(runningApp->getLaunchPointId());
         lunaTask->setAppId(runningApp->getAppId());
@@ -178,55 +181,37 @@ RunningAppPtr RunningAppList::getByInstanceId(const string& instanceId)
 
 RunningAppPtr RunningAppList::getByAppId(const string& appId, const int displayId)
 {
-    for (auto it = m_map.begin(); it != m_map.end(); ++it) {
-        if ((*it).second->getAppId() == appId) {
-            if (displayId == -1)
-                return it->second;
-            if ((*it).second->getDisplayId() == displayId)
-                return it->second;
-        }
+    const map<string, RunningAppPtr>* runningApps = m_appIdIndex.findAll(appId);
+    if (runningApps == nullptr)
+        return nullptr;
+
+    for (auto it = runningApps->begin(); it != runningApps->end(); ++it) {
+        if (displayId == -1)
+            return it->second;
+        if ((*it).second->getDisplayId() == displayId)
+            return it->second;
     }
     return nullptr;
 }
 
 RunningAppPtr RunningAppList::getByToken(const LSMessageToken& token)
 {
-    for (auto it = m_map.begin(); it != m_map.end(); ++it) {
-        if ((*it).second->getToken() == token) {
-            return it->second;
-        }
-    }
-    return nullptr;
+    return m_tokenIndex.find(token);
 }
 
 RunningAppPtr RunningAppList::getByLS2Name(const string& ls2name)
 {
-    for (auto it = m_map.begin(); it != m_map.end(); ++it) {
-        if ((*it).second->getLS2Name() == ls2name) {
-            return it->second;
-        }
-    }
-    return nullptr;
+    return m_ls2nameIndex.find(ls2name);
 }
 
 RunningAppPtr RunningAppList::getByPid(const pid_t pid)
 {
-    for (auto it = m_map.begin(); it != m_map.end(); ++it) {
-        if ((*it).second->getProcessId() == pid) {
-            return it->second;
-        }
-    }
-    return nullptr;
+    return m_pidIndex.find(pid);
 }
 
 RunningAppPtr RunningAppList::getByWebprocessid(const string& webprocessid)
 {
-    for (auto it = m_map.begin(); it != m_map.end(); ++it) {
-        if ((*it).second->getWebprocessid() == webprocessid) {
-            return it->second;
-        }
-    }
-    return nullptr;
+    return m_webprocessidIndex.find(webprocessid);
 }
 
 bool RunningAppList::add(RunningAppPtr runningApp)
@@ -242,6 +227,7 @@ bool RunningAppList::add(RunningAppPtr runningApp)
         return false;
     }
     m_map[runningApp->getInstanceId()] = runningApp;
+    addIndexes(runningApp);
     onAdd(std::move(runningApp));
     return true;
 }
@@ -251,46 +237,40 @@ void RunningAppList::removeByObject(RunningAppPtr runningApp)
     if (runningApp == nullptr)
         return;
 
-    for (auto it = m_map.begin(); it != m_map.end(); ++it) {
-        if ((*it).second == runningApp) {
-            RunningAppPtr ptr = it->second;
-            m_map.erase(it);
-            onRemove(std::move(ptr));
-            return;
-        }
-    }
+    auto it = m_map.find(runningApp->getInstanceId());
+    if (it == m_map.end() || it->second != runningApp)
+        return;
+
+    erase(it);
+    onRemove(std::move(runningApp));
 }
 
 void RunningAppList::removeByInstanceId(const string& instanceId)
 {
-    for (auto it = m_map.begin(); it != m_map.end(); ++it) {
-        if ((*it).second->getInstanceId() == instanceId) {
-            RunningAppPtr ptr = it->second;
-            m_map.erase(it);
-            onRemove(std::move(ptr));
-            return;
-        }
-    }
+    auto it = m_map.find(instanceId);
+    if (it == m_map.end())
+        return;
+
+    RunningAppPtr ptr = it->second;
+    erase(it);
+    onRemove(std::move(ptr));
 }
 
 void RunningAppList::removeByPid(const pid_t pid)
 {
-    for (auto it = m_map.begin(); it != m_map.end(); ++it) {
-        if ((*it).second->getProcessId() == pid) {
-            RunningAppPtr ptr = it->second;
-            m_map.erase(it);
-            onRemove(std::move(ptr));
-            return;
-        }
-    }
+    RunningAppPtr ptr = getByPid(pid);
+    if (ptr == nullptr)
+        return;
+
+    removeByObject(std::move(ptr));
 }
 
 void RunningAppList::removeAllByType(AppType type)
 {
-    for (auto it = m_map.cbegin(); it != m_map.cend() ;) {
+    for (auto it = m_map.begin(); it != m_map.end() ;) {
         if (it->second->getLaunchPoint()->getAppDesc()->getAppType() == type) {
             RunningAppPtr ptr = it->second;
-            it = m_map.erase(it);
+            it = erase(it);
             onRemove(std::move(ptr));
         } else {
             ++it;
@@ -300,14 +280,14 @@ void RunningAppList::removeAllByType(AppType type)
 
 void RunningAppList::removeAllByConext(AppType type, const int context)
 {
-    for (auto it = m_map.cbegin(); it != m_map.cend() ;) {
+    for (auto it = m_map.begin(); it != m_map.end() ;) {
         if (it->second->getLaunchPoint()->getAppDesc()->getAppType() == type &&
             it->second->getContext() == context &&
             it->second->getLifeStatus() != LifeStatus::LifeStatus_LAUNCHING &&
             it->second->getLifeStatus() != LifeStatus::LifeStatus_SPLASHING) {
             // Apps which is in LifeStatus_LAUNCHING & LifeStatus_SPLASHING should not be removed
             RunningAppPtr ptr = it->second;
-            it = m_map.erase(it);
+            it = erase(it);
             onRemove(std::move(ptr));
         } else {
             ++it;
@@ -317,10 +297,10 @@ void RunningAppList::removeAllByConext(AppType type, const int context)
 
 void RunningAppList::removeAllByLaunchPoint(LaunchPointPtr launchPoint)
 {
-    for (auto it = m_map.cbegin(); it != m_map.cend() ;) {
+    for (auto it = m_map.begin(); it != m_map.end() ;) {
         if (it->second->getLaunchPoint() == launchPoint) {
             RunningAppPtr ptr = it->second;
-            it = m_map.erase(it);
+            it = erase(it);
             onRemove(std::move(ptr));
         } else {
             ++it;
@@ -328,6 +308,26 @@ void RunningAppList::removeAllByLaunchPoint(LaunchPointPtr launchPoint)
     }
 }
 
+void RunningAppList::reindexByLaunchPoint(const LaunchPoint& launchPoint)
+{
+    for (auto it = m_map.begin(); it != m_map.end(); ++it) {
+        if (it->second->getLaunchPoint().get() == &launchPoint)
+            reindex(*it->second);
+    }
+}
+
+void RunningAppList::reindex(RunningApp& runningApp)
+{
+    auto it = m_map.find(runningApp.getInstanceId());
+    if (it == m_map.end() || it->second.get() != &runningApp)
+        return;
+
+    // pid can be changed without setter. See NativeContainer
+    runningApp.invalidateRunningJson();
+    removeIndexes(it->first);
+    addIndexes(it->second);
+}
+
 bool RunningAppList::setConext(AppType type, const int context)
 {
     for (auto it = m_map.begin(); it != m_map.end(); ++it) {
@@ -340,15 +340,27 @@ bool RunningAppList::setConext(AppType type, const int context)
 
 bool RunningAppList::isTransition(bool devmodeOnly)
 {
+#ifdef SAM_CHECK_INVARIANTS
+    // Counters should be same with full scan. Otherwise, reindex is missed somewhere.
+    int transitionCount = 0;
+    int devmodeTransitionCount = 0;
     for (auto it = m_map.begin(); it != m_map.end(); ++it) {
-        if (devmodeOnly) {
-            if ((*it).second->getLaunchPoint()->getAppDesc()->isDevmodeApp() &&
-                (*it).second->isTransition()) return true;
-        } else {
-            if ((*it).second->isTransition()) return true;
-        }
+        if (!(*it).second->isTransition())
+            continue;
+        transitionCount++;
+        if ((*it).second->getLaunchPoint()->getAppDesc()->isDevmodeApp())
+            devmodeTransitionCount++;
+    }
+    if (transitionCount != m_transitionCount || devmodeTransitionCount != m_devmodeTransitionCount) {
+        Logger::error(getClassName(), __FUNCTION__,
+                      Logger::format("Invalid transition counter: all(%d/%d) devmode(%d/%d)",
+                                     m_transitionCount, transitionCount, m_devmodeTransitionCount, devmodeTransitionCount));
     }
-    return false;
+#endif
+
+    if (devmodeOnly)
+        return m_devmodeTransitionCount > 0;
+    return m_transitionCount > 0;
 }
 
 void RunningAppList::toJson(JValue& array, bool devmodeOnly)
@@ -361,12 +373,39 @@ void RunningAppList::toJson(JValue& array, bool devmodeOnly)
              continue;
          }
 
-         pbnjson::JValue object = pbnjson::Object();
-         it->second->toAPIJson(object, true);
-         array.append(object);
+         array.append(it->second->getRunningJson());
     }
 }
 
+void RunningAppList::toLaunchPhaseJson(JValue& array)
+{
+    if (!array.isArray())
+        return;
+
+    for (auto it = m_map.begin(); it != m_map.end(); ++it) {
+        JValue item = pbnjson::Object();
+        item.put("instanceId", it->second->getInstanceId());
+        item.put("appId", it->second->getAppId());
+        item.put("type", AppDescription::toString(it->second->getLaunchPoint()->getAppDesc()->getAppType()));
+
+        JValue launchPhases = pbnjson::Object();
+        it->second->toLaunchPhaseJson(launchPhases);
+        item.put("launchPhases", launchPhases);
+        array.append(item);
+    }
+}
+
+const string& RunningAppList::toSerializedJson(bool devmodeOnly)
+{
+    string& serialized = devmodeOnly ? m_serializedDevRunning : m_serializedRunning;
+    if (serialized.empty()) {
+        pbnjson::JValue array = pbnjson::Array();
+        toJson(array, devmodeOnly);
+        serialized = array.stringify();
+    }
+    return serialized;
+}
+
 void RunningAppList::onAdd(RunningAppPtr runningApp)
 {
     // Status should be defined before calling this method
@@ -380,3 +419,63 @@ void RunningAppList::onRemove(RunningAppPtr runningApp)
     runningApp->setLifeStatus(LifeStatus::LifeStatus_STOP);
     ApplicationManager::getInstance().postRunning(std::move(runningApp));
 }
+
+void RunningAppList::addIndexes(const RunningAppPtr& runningApp)
+{
+    m_serializedRunning.clear();
+    m_serializedDevRunning.clear();
+
+    IndexKeys& keys = m_indexKeys[runningApp->getInstanceId()];
+    keys.m_appId = runningApp->getAppId();
+    keys.m_token = runningApp->getToken();
+    keys.m_pid = runningApp->getProcessId();
+    keys.m_ls2name = runningApp->getLS2Name();
+    keys.m_webprocessid = runningApp->getWebprocessid();
+    keys.m_isTransition = runningApp->isTransition();
+    keys.m_isDevmode = runningApp->getLaunchPoint()->getAppDesc()->isDevmodeApp();
+
+    if (keys.m_isTransition) {
+        m_transitionCount++;
+        if (keys.m_isDevmode)
+            m_devmodeTransitionCount++;
+    }
+
+    // default values are not indexed because they don't identify any runningApp
+    const string& instanceId = runningApp->getInstanceId();
+    m_appIdIndex.add(keys.m_appId, instanceId, runningApp);
+    if (keys.m_token != 0)
+        m_tokenIndex.add(keys.m_token, instanceId, runningApp);
+    if (keys.m_pid > 0)
+        m_pidIndex.add(keys.m_pid, instanceId, runningApp);
+    if (!keys.m_ls2name.empty())
+        m_ls2nameIndex.add(keys.m_ls2name, instanceId, runningApp);
+    if (!keys.m_webprocessid.empty())
+        m_webprocessidIndex.add(keys.m_webprocessid, instanceId, runningApp);
+}
+
+void RunningAppList::removeIndexes(const string& instanceId)
+{
+    auto it = m_indexKeys.find(instanceId);
+    if (it == m_indexKeys.end())
+        return;
+
+    m_serializedRunning.clear();
+    m_serializedDevRunning.clear();
+    m_appIdIndex.remove(it->second.m_appId, instanceId);
+    m_tokenIndex.remove(it->second.m_token, instanceId);
+    m_pidIndex.remove(it->second.m_pid, instanceId);
+    m_ls2nameIndex.remove(it->second.m_ls2name, instanceId);
+    m_webprocessidIndex.remove(it->second.m_webprocessid, instanceId);
+    if (it->second.m_isTransition) {
+        m_transitionCount--;
+        if (it->second.m_isDevmode)
+            m_devmodeTransitionCount--;
+    }
+    m_indexKeys.erase(it);
+}
+
+map<string, RunningAppPtr>::iterator RunningAppList::erase(map<string, RunningAppPtr>::iterator it)
+{
+    removeIndexes(it->first);
+    return m_map.erase(it);
+}
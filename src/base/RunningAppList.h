@@ -24,6 +24,7 @@
 #include "interface/ISingleton.h"
 #include "interface/IClassName.h"
 #include "RunningApp.h"
+#include "util/SecondaryIndex.h"
 
 using namespace std;
 
@@ -56,17 +57,57 @@ public:
     void removeAllByConext(AppType type, const int context);
     void removeAllByLaunchPoint(LaunchPointPtr launchPoint);
 
+    // Should be called whenever indexed keys (appId, token, pid, ls2name, webprocessid, lifeStatus)
+    // or fields of 'running' list (displayId) are changed
+    void reindex(RunningApp& runningApp);
+    // 'running' fields from AppDescription (appType, defaultWindowType, devmode) are changed
+    void reindexByLaunchPoint(const LaunchPoint& launchPoint);
+
     bool setConext(AppType type, const int context);
     bool isTransition(bool devmodeOnly);
     void toJson(JValue& array, bool devmodeOnly = false);
+    void toLaunchPhaseJson(JValue& array);
+
+    // Returns serialized 'running' array. It is cached until the list or any item is changed.
+    const string& toSerializedJson(bool devmodeOnly = false);
 
 private:
+    struct IndexKeys {
+        string m_appId;
+        LSMessageToken m_token;
+        pid_t m_pid;
+        string m_ls2name;
+        string m_webprocessid;
+        bool m_isTransition;
+        bool m_isDevmode;
+    };
+
     void onAdd(RunningAppPtr runningApp);
     void onRemove(RunningAppPtr runningApp);
 
     RunningAppList();
 
+    void addIndexes(const RunningAppPtr& runningApp);
+    void removeIndexes(const string& instanceId);
+    map<string, RunningAppPtr>::iterator erase(map<string, RunningAppPtr>::iterator it);
+
     map<string, RunningAppPtr> m_map;
+
+    // Each index keeps instances in instanceId order like m_map
+    map<string, IndexKeys> m_indexKeys;
+    SecondaryIndex<string, RunningAppPtr> m_appIdIndex;
+    SecondaryIndex<LSMessageToken, RunningAppPtr> m_tokenIndex;
+    SecondaryIndex<pid_t, RunningAppPtr> m_pidIndex;
+    SecondaryIndex<string, RunningAppPtr> m_ls2nameIndex;
+    SecondaryIndex<string, RunningAppPtr> m_webprocessidIndex;
+
+    // number of apps in transition. Each is updated with indexes
+    int m_transitionCount;
+    int m_devmodeTransitionCount;
+
+    // empty string means 'not cached'
+    string m_serializedRunning;
+    string m_serializedDevRunning;
 };
 
 #endif /* BASE_RUNNINGAPPLIST_H_ */
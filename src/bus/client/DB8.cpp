@@ -16,6 +16,7 @@
 
 #include "DB8.h"
 
+#include "base/BootTimeline.h"
 #include "base/LaunchPointList.h"
 #include "bus/service/ApplicationManager.h"
 #include "conf/SAMConf.h"
@@ -36,7 +37,8 @@ bool DB8::onResponse(LSHandle* sh, LSMessage* message, void* context)
 }
 
 DB8::DB8()
-    : AbsLunaClient("com.webos.service.db")
+    : AbsLunaClient("com.webos.service.db"),
+      m_findTime(0)
 {
     setClassName("DB8");
 }
@@ -220,6 +222,8 @@ bool DB8::onFind(LSHandle* sh, LSMessage* message, void* context)
         }
     }
     Logger::info(getInstance().getClassName(), __FUNCTION__, "Complete to sync DB8");
+    BootTimeline::getInstance().addDuration("DB8::find", "db8", getInstance().m_findTime);
+    BootTimeline::getInstance().dump();
 
     // 여기서 LaunchPoints를 만들어 넣어야 함.
     return true;
@@ -234,6 +238,8 @@ void DB8::find()
     requestPayload["query"].put("from", KIND_NAME);
     requestPayload["query"].put("orderBy", "_rev");
 
+    m_findTime = Time::getCurrentTimeUs();
+
     Logger::logCallRequest(getClassName(), __FUNCTION__, method, requestPayload);
     if (!LSCallOneReply(
         ApplicationManager::getInstance().get(),
@@ -59,6 +59,8 @@ private:
 
     DB8();
 
+    // monotonic time(us) when 'find' is called
+    long long m_findTime;
 };
 
 #endif /* BUS_CLIENT_DB8_H_ */
@@ -93,6 +93,7 @@ void MemoryManager::requireMemory(RunningAppPtr runningApp, LunaTaskPtr lunaTask
 
     LSErrorSafe error;
     LSMessageToken token = 0;
+    long long requestedTime = Time::getCurrentTimeNs();
     Logger::logCallRequest(getClassName(), __FUNCTION__, method, requestPayload);
     if (!LSCallOneReply(
         ApplicationManager::getInstance().get(),
@@ -107,6 +108,8 @@ void MemoryManager::requireMemory(RunningAppPtr runningApp, LunaTaskPtr lunaTask
         lunaTask->success(lunaTask);
         return;
     }
+    // Memory phases are stamped only if MemoryManager really handles the request
+    runningApp->setLaunchPhaseTime(LaunchPhase::LaunchPhase_MEMORY_REQUESTED, requestedTime);
     lunaTask->setToken(token);
     runningApp->setToken(token);
 }
@@ -16,44 +16,72 @@
 
 #include "NativeContainer.h"
 
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
 #include "base/AppDescription.h"
 #include "base/LunaTaskList.h"
 #include "base/AppDescriptionList.h"
 #include "base/RunningAppList.h"
 #include "conf/SAMConf.h"
 #include "conf/RuntimeInfo.h"
+#include "util/ChildReaper.h"
 
 const string NativeContainer::KEY_NATIVE_RUNNING_APPS = "nativeRunningApps";
 int NativeContainer::s_instanceCounter = 1;
+int NativeContainer::s_warmRunnerCounter = 1;
 
-void NativeContainer::onKillChildProcess(GPid pid, gint status, gpointer data)
+void NativeContainer::onChildrenExited(const vector<ChildExit>& exits)
 {
-    static string lastLogFile = "";
+    NativeContainer& self = getInstance();
+    set<pid_t> pids;
+    for (const ChildExit& exit : exits) {
+        if (self.handleExit(exit))
+            pids.insert(exit.m_pid);
+    }
+    // 'nativeRunningApps' is updated once for all exits in the batch
+    self.removeItems(pids);
+}
 
-    Logger::info(getInstance().getClassName(), __FUNCTION__, Logger::format("Process(%d) was killed with status(%d)", pid, status));
-    g_spawn_close_pid(pid);
+bool NativeContainer::isWarmRunnerType(AppType type)
+{
+    switch (type) {
+    case AppType::AppType_Native_Qml:
+    case AppType::AppType_Native_AppShell:
+    case AppType::AppType_Native_BrowserShell:
+        return true;
 
-    RunningAppPtr runningApp = RunningAppList::getInstance().getByPid(pid);
-    if (runningApp && !runningApp->getLinuxProcess().getStdFile().empty()) {
-        if (!lastLogFile.empty()) {
-            File::deleteFile(lastLogFile);
-        }
-        lastLogFile = runningApp->getLinuxProcess().getStdFile();
-    }
-    LunaTaskPtr lunaTask = LunaTaskList::getInstance().getByToken(pid);
-    if (runningApp == nullptr) {
-        Logger::error(getInstance().getClassName(), __FUNCTION__, "Cannot find RunningApp");
-        return;
+    default:
+        return false;
     }
+}
 
-    getInstance().removeItem(pid);
-    RunningAppList::getInstance().removeByObject(std::move(runningApp));
-    if (lunaTask) {
-        lunaTask->success(lunaTask);
+gboolean NativeContainer::onRefillWarmRunners(gpointer context)
+{
+    NativeContainer& self = getInstance();
+    static const AppType types[] = {
+        AppType::AppType_Native_Qml,
+        AppType::AppType_Native_AppShell,
+        AppType::AppType_Native_BrowserShell
+    };
+
+    // Only one runner is spawned in each idle callback not to block main loop
+    for (AppType type : types) {
+        if (self.m_warmRunnerFailures[type] >= MAX_WARM_RUNNER_FAILURES)
+            continue;
+        if ((int) self.m_warmRunners[type].size() >= SAMConf::getInstance().getWarmRunnerCount(AppDescription::toString(type)))
+            continue;
+        if (!self.spawnWarmRunner(type))
+            self.m_warmRunnerFailures[type]++;
+        return G_SOURCE_CONTINUE;
     }
+    self.m_refillSource = 0;
+    return G_SOURCE_REMOVE;
 }
 
 NativeContainer::NativeContainer()
+    : m_refillSource(0)
 {
     setClassName("NativeContainer");
 }
@@ -68,13 +96,20 @@ void NativeContainer::initialize()
     // Getting global environments
     gchar **variables = g_listenv();
     gsize size = variables ? g_strv_length(variables) : 0;
+    shared_ptr<vector<string>> baseEnvironment = make_shared<vector<string>>();
+    baseEnvironment->reserve(size);
     for (uint i = 0; i < size; i++) {
     const gchar *value = g_getenv(variables[i]);
         if (value != NULL) {
-            m_environments[variables[i]] = value;
+            baseEnvironment->push_back(string(variables[i]) + "=" + value);
         }
     }
     g_strfreev(variables);
+    m_baseEnvironment = std::move(baseEnvironment);
+
+    ChildReaper::getInstance().setHandler(onChildrenExited);
+
+    scheduleRefillWarmRunners();
 
     // Load already running native apps
     if (!RuntimeInfo::getInstance().getValue(KEY_NATIVE_RUNNING_APPS, m_nativeRunninApps)) {
@@ -101,8 +136,29 @@ void NativeContainer::initialize()
     RuntimeInfo::getInstance().setValue(KEY_NATIVE_RUNNING_APPS, m_nativeRunninApps);
 }
 
+void NativeContainer::finalize()
+{
+    if (m_refillSource != 0) {
+        g_source_remove(m_refillSource);
+        m_refillSource = 0;
+    }
+    for (auto& it : m_warmRunners) {
+        for (WarmRunner& runner : it.second) {
+            runner.m_process.kill();
+            unlink(runner.m_fifoPath.c_str());
+        }
+    }
+    m_warmRunners.clear();
+    m_discardedWarmRunners.clear();
+    if (!m_warmRunnerDir.empty()) {
+        rmdir(m_warmRunnerDir.c_str());
+        m_warmRunnerDir.clear();
+    }
+}
+
 void NativeContainer::launch(RunningAppPtr runningApp, LunaTaskPtr lunaTask)
 {
+    runningApp->setLaunchPhaseTime(LaunchPhase::LaunchPhase_SPAWNING);
     AppType type = runningApp->getLaunchPoint()->getAppDesc()->getAppType();
 
     JValue params;
@@ -192,7 +248,7 @@ void NativeContainer::launch(RunningAppPtr runningApp, LunaTaskPtr lunaTask)
         }
     }
 
-    runningApp->getLinuxProcess().addEnv(m_environments);
+    runningApp->getLinuxProcess().setBaseEnv(m_baseEnvironment);
     runningApp->getLinuxProcess().addEnv("INSTANCE_ID", runningApp->getInstanceId());
     runningApp->getLinuxProcess().addEnv("LAUNCHPOINT_ID", runningApp->getLaunchPointId());
     runningApp->getLinuxProcess().addEnv("APP_ID", runningApp->getAppId());
@@ -200,21 +256,29 @@ void NativeContainer::launch(RunningAppPtr runningApp, LunaTaskPtr lunaTask)
     runningApp->getLinuxProcess().addEnv("LS2_NAME", Logger::format("%s-%d", runningApp->getAppId().c_str(), s_instanceCounter));
 
     runningApp->setLS2Name(Logger::format("%s-%d", runningApp->getAppId().c_str(), s_instanceCounter));
-    if (RuntimeInfo::getInstance().getUser().empty())
+
+    // Warm runner keeps its own log file
+    bool isWarm = isWarmRunnerType(appType) && handoffWarmRunner(runningApp);
+    if (isWarm)
+        s_instanceCounter++;
+    else if (RuntimeInfo::getInstance().getUser().empty())
         runningApp->getLinuxProcess().openStdFile(Logger::format("/var/log/%s-%d", runningApp->getAppId().c_str(), s_instanceCounter++));
     else
         runningApp->getLinuxProcess().openStdFile(Logger::format("/var/log/%s-%s-%d", runningApp->getAppId().c_str(), RuntimeInfo::getInstance().getUser().c_str(), s_instanceCounter++));
 
     runningApp->setLifeStatus(LifeStatus::LifeStatus_LAUNCHING);
 
-    if (!runningApp->getLinuxProcess().run()) {
+    if (!isWarm && !runningApp->getLinuxProcess().run()) {
         RunningAppList::getInstance().removeByObject(runningApp);
         lunaTask->setErrCodeAndText(ErrCode_LAUNCH, "Failed to launch process");
         lunaTask->error(lunaTask);
         return;
     }
 
-    g_child_watch_add(runningApp->getLinuxProcess().getPid(), onKillChildProcess, nullptr);
+    runningApp->setLaunchPhaseTime(LaunchPhase::LaunchPhase_SPAWNED);
+    // pid is assigned by NativeProcess directly
+    RunningAppList::getInstance().reindex(*runningApp);
+    // The process is watched by ChildReaper since NativeProcess::run()
     runningApp->getLinuxProcess().track();
 
     addItem(runningApp->getInstanceId(), runningApp->getLaunchPointId(), runningApp->getProcessId(), runningApp->getDisplayId());
@@ -244,7 +308,7 @@ void NativeContainer::close(RunningAppPtr runningApp, LunaTaskPtr lunaTask)
     lunaTask->setToken(runningApp->getProcessId());
 
     if (!runningApp->getLinuxProcess().isTracked()) {
-        NativeContainer::onKillChildProcess(runningApp->getProcessId(), 0, NULL);
+        NativeContainer::onChildrenExited(vector<ChildExit>(1, ChildExit(runningApp->getProcessId())));
         lunaTask->success(lunaTask);
     }
 }
@@ -258,16 +322,65 @@ void NativeContainer::kill(RunningAppPtr runningApp)
     runningApp->setToken(runningApp->getProcessId());
 }
 
-void NativeContainer::removeItem(GPid pid)
+bool NativeContainer::handleExit(const ChildExit& exit)
+{
+    static string lastLogFile = "";
+    pid_t pid = exit.m_pid;
+
+    if (!exit.m_hasStatus)
+        Logger::info(getClassName(), __FUNCTION__, Logger::format("Process(%d) was terminated", pid));
+    else if (WIFSIGNALED(exit.m_status))
+        Logger::info(getClassName(), __FUNCTION__, Logger::format("Process(%d) was killed by signal(%d)", pid, WTERMSIG(exit.m_status)));
+    else
+        Logger::info(getClassName(), __FUNCTION__, Logger::format("Process(%d) exited with code(%d)", pid, WEXITSTATUS(exit.m_status)));
+    if (exit.m_hasUsage) {
+        Logger::info(getClassName(), __FUNCTION__, Logger::format("Process(%d) used utime(%ld ms) stime(%ld ms) maxrss(%ld KB)", pid,
+                     exit.m_usage.ru_utime.tv_sec * 1000 + exit.m_usage.ru_utime.tv_usec / 1000,
+                     exit.m_usage.ru_stime.tv_sec * 1000 + exit.m_usage.ru_stime.tv_usec / 1000,
+                     exit.m_usage.ru_maxrss));
+    }
+
+    RunningAppPtr runningApp = RunningAppList::getInstance().getByPid(pid);
+    if (runningApp && !runningApp->getLinuxProcess().getStdFile().empty()) {
+        if (!lastLogFile.empty()) {
+            File::deleteFile(lastLogFile);
+        }
+        lastLogFile = runningApp->getLinuxProcess().getStdFile();
+    }
+    if (m_discardedWarmRunners.erase(pid) != 0)
+        return false;
+
+    LunaTaskPtr lunaTask = LunaTaskList::getInstance().getByToken(pid);
+    if (runningApp == nullptr) {
+        if (removeWarmRunner(pid))
+            return false;
+        Logger::error(getClassName(), __FUNCTION__, "Cannot find RunningApp");
+        return false;
+    }
+
+    // Exit status is published with 'stop' event
+    runningApp->getLinuxProcess().setExit(exit);
+    RunningAppList::getInstance().removeByObject(std::move(runningApp));
+    if (lunaTask) {
+        lunaTask->success(lunaTask);
+    }
+    return true;
+}
+
+void NativeContainer::removeItems(const set<pid_t>& pids)
 {
-    gsize size = getInstance().m_nativeRunninApps.arraySize();
-    for (gsize i = 0; i < size; ++i) {
-        if (m_nativeRunninApps[i]["processId"].asNumber<int>() == pid) {
+    if (pids.empty())
+        return;
+
+    bool isRemoved = false;
+    for (int i = (int) m_nativeRunninApps.arraySize() - 1; i >= 0; --i) {
+        if (pids.count(m_nativeRunninApps[i]["processId"].asNumber<int>()) != 0) {
             m_nativeRunninApps.remove(i);
-            RuntimeInfo::getInstance().setValue(KEY_NATIVE_RUNNING_APPS, m_nativeRunninApps);
-            break;
+            isRemoved = true;
         }
     }
+    if (isRemoved)
+        RuntimeInfo::getInstance().setValue(KEY_NATIVE_RUNNING_APPS, m_nativeRunninApps);
 }
 
 void NativeContainer::addItem(const string& instanceId, const string& launchPointId, const int processId, const int displayId)
@@ -281,3 +394,130 @@ void NativeContainer::addItem(const string& instanceId, const string& launchPoin
     RuntimeInfo::getInstance().setValue(KEY_NATIVE_RUNNING_APPS, m_nativeRunninApps);
 }
 
+
+void NativeContainer::scheduleRefillWarmRunners()
+{
+    if (m_refillSource != 0)
+        return;
+    m_refillSource = g_idle_add_full(G_PRIORITY_LOW, onRefillWarmRunners, nullptr, nullptr);
+}
+
+bool NativeContainer::spawnWarmRunner(AppType type)
+{
+    const string* runnerPath = nullptr;
+    switch (type) {
+    case AppType::AppType_Native_Qml:
+        runnerPath = &SAMConf::getInstance().getQmlRunnerPath();
+        break;
+    case AppType::AppType_Native_AppShell:
+        runnerPath = &SAMConf::getInstance().getAppShellRunnerPath();
+        break;
+    case AppType::AppType_Native_BrowserShell:
+        runnerPath = &SAMConf::getInstance().getBrowserShellRunnerPath();
+        break;
+    default:
+        return false;
+    }
+
+    // fifos are created in the private directory. Names in /tmp can be taken by others
+    if (m_warmRunnerDir.empty()) {
+        char dir[] = "/tmp/sam-warm-runners-XXXXXX";
+        if (mkdtemp(dir) == NULL) {
+            Logger::warning(getClassName(), __FUNCTION__, Logger::format("Failed to create directory: %s", strerror(errno)));
+            return false;
+        }
+        m_warmRunnerDir = dir;
+    }
+
+    WarmRunner runner;
+    runner.m_fifoPath = File::join(m_warmRunnerDir, Logger::format("runner-%d", s_warmRunnerCounter));
+    if (mkfifo(runner.m_fifoPath.c_str(), 0600) != 0) {
+        Logger::warning(getClassName(), __FUNCTION__, Logger::format("Failed to create fifo: %s", strerror(errno)));
+        return false;
+    }
+
+    runner.m_process.setCommand(*runnerPath);
+    runner.m_process.addArgument("--handoff", runner.m_fifoPath);
+    runner.m_process.setBaseEnv(m_baseEnvironment);
+    runner.m_process.openStdFile(Logger::format("/var/log/warm-runner-%d", s_warmRunnerCounter++));
+    if (!runner.m_process.run()) {
+        runner.m_process.closeStdFd();
+        unlink(runner.m_fifoPath.c_str());
+        return false;
+    }
+    // The runner has its own copy
+    runner.m_process.closeStdFd();
+
+    Logger::info(getClassName(), __FUNCTION__, AppDescription::toString(type), Logger::format("Warm runner(%d) is spawned", runner.m_process.getPid()));
+    m_warmRunners[type].push_back(std::move(runner));
+    return true;
+}
+
+bool NativeContainer::handoffWarmRunner(RunningAppPtr runningApp)
+{
+    AppType type = runningApp->getLaunchPoint()->getAppDesc()->getAppType();
+    deque<WarmRunner>& runners = m_warmRunners[type];
+    if (runners.empty())
+        return false;
+
+    // O_NONBLOCK open fails with ENXIO if the runner doesn't wait on the fifo yet
+    int fd = open(runners.front().m_fifoPath.c_str(), O_WRONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        Logger::info(getClassName(), __FUNCTION__, runningApp->getAppId(), "Warm runner is not ready. Launch new process");
+        return false;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+
+    JValue message = pbnjson::Object();
+    JValue args = pbnjson::Array();
+    for (const string& argument : runningApp->getLinuxProcess().getArguments()) {
+        args.append(argument);
+    }
+    JValue env = pbnjson::Object();
+    for (const auto& it : runningApp->getLinuxProcess().getEnvironments()) {
+        env.put(it.first, it.second);
+    }
+    message.put("args", args);
+    message.put("env", env);
+    string line = message.stringify() + "\n";
+
+    bool isWritten = (write(fd, line.c_str(), line.size()) == (ssize_t) line.size());
+    ::close(fd);
+
+    WarmRunner runner = std::move(runners.front());
+    runners.pop_front();
+    unlink(runner.m_fifoPath.c_str());
+    scheduleRefillWarmRunners();
+
+    if (!isWritten) {
+        Logger::warning(getClassName(), __FUNCTION__, runningApp->getAppId(), "Failed to hand off. Launch new process");
+        m_warmRunnerFailures[type]++;
+        // Its exit is not related to any RunningApp
+        m_discardedWarmRunners.insert(runner.m_process.getPid());
+        runner.m_process.kill();
+        return false;
+    }
+
+    m_warmRunnerFailures[type] = 0;
+    runningApp->getLinuxProcess() = runner.m_process;
+    Logger::info(getClassName(), __FUNCTION__, runningApp->getAppId(), Logger::format("launch with warm runner(%d)", runner.m_process.getPid()));
+    return true;
+}
+
+bool NativeContainer::removeWarmRunner(GPid pid)
+{
+    for (auto& it : m_warmRunners) {
+        for (auto runner = it.second.begin(); runner != it.second.end(); ++runner) {
+            if (runner->m_process.getPid() != pid)
+                continue;
+
+            Logger::warning(getClassName(), __FUNCTION__, AppDescription::toString(it.first), Logger::format("Warm runner(%d) exited before handoff", pid));
+            unlink(runner->m_fifoPath.c_str());
+            it.second.erase(runner);
+            m_warmRunnerFailures[it.first]++;
+            scheduleRefillWarmRunners();
+            return true;
+        }
+    }
+    return false;
+}
@@ -17,8 +17,10 @@
 #ifndef BUS_CLIENT_NATIVECONTAINER_H_
 #define BUS_CLIENT_NATIVECONTAINER_H_
 
+#include <deque>
 #include <list>
 #include <memory>
+#include <set>
 #include <vector>
 
 #include "base/LaunchPointList.h"
@@ -27,6 +29,7 @@
 #include "interface/ISingleton.h"
 #include "interface/IClassName.h"
 #include "AbsLifeHandler.h"
+#include "util/ChildReaper.h"
 #include "util/NativeProcess.h"
 
 class NativeContainer : public ISingleton<NativeContainer>,
@@ -34,11 +37,12 @@ class NativeContainer : public ISingleton<NativeContainer>,
                         public AbsLifeHandler {
 friend class ISingleton<NativeContainer>;
 public:
-    static void onKillChildProcess(GPid pid, gint status, gpointer data);
+    static void onChildrenExited(const vector<ChildExit>& exits);
 
     virtual ~NativeContainer();
 
     virtual void initialize();
+    void finalize();
 
     // AbsLifeHandler
     virtual void launch(RunningAppPtr runningApp, LunaTaskPtr lunaTask) override;
@@ -49,16 +53,46 @@ public:
 private:
     static const string KEY_NATIVE_RUNNING_APPS;
 
+    static const int MAX_WARM_RUNNER_FAILURES = 3;
+
     static int s_instanceCounter;
+    static int s_warmRunnerCounter;
+
+    static bool isWarmRunnerType(AppType type);
+    static gboolean onRefillWarmRunners(gpointer context);
 
     NativeContainer();
 
-    virtual void removeItem(GPid pid);
+    // Returns true if the exited process was a running app
+    bool handleExit(const ChildExit& exit);
+    void removeItems(const set<pid_t>& pids);
     virtual void addItem(const string& instanceId, const string& launchPointId, const int processId, const int displayId);
 
-    map<string, string> m_environments;
+    // Idle runner process which waits for an app on its handoff fifo.
+    // The runner reads one JSON line {"args":[...], "env":{...}}. 'args' is same with cold launch arguments.
+    struct WarmRunner {
+        NativeProcess m_process;
+        string m_fifoPath;
+    };
+
+    void scheduleRefillWarmRunners();
+    bool spawnWarmRunner(AppType type);
+    bool handoffWarmRunner(RunningAppPtr runningApp);
+    bool removeWarmRunner(GPid pid);
+
+    // Environments of SAM. It is shared by all native processes
+    BaseEnvironmentPtr m_baseEnvironment;
     JValue m_nativeRunninApps;
 
+    map<AppType, deque<WarmRunner>> m_warmRunners;
+    // consecutive exits before handoff. Refilling stops if it reaches MAX_WARM_RUNNER_FAILURES
+    map<AppType, int> m_warmRunnerFailures;
+    guint m_refillSource;
+    // runners killed after failed handoff. They are not in m_warmRunners anymore
+    set<pid_t> m_discardedWarmRunners;
+    // private directory (0700) for handoff fifos
+    string m_warmRunnerDir;
+
 };
 
 #endif
@@ -161,6 +161,7 @@ bool WAM::onLaunchApp(LSHandle* sh, LSMessage* message, void* context)
         lunaTask->error(lunaTask);
         return true;
     }
+    runningApp->setLaunchPhaseTime(LaunchPhase::LaunchPhase_SPAWNED);
     if (runningApp->isFirstLaunch()) {
         if (!runningApp->getPreload().empty()) {
             runningApp->setLifeStatus(LifeStatus::LifeStatus_PRELOADED);
@@ -189,10 +190,8 @@ void WAM::launch(RunningAppPtr runningApp, LunaTaskPtr lunaTask)
         return;
     }
 
-    JValue appDesc = pbnjson::Object();
-    runningApp->getLaunchPoint()->toJson(appDesc);
-
-    requestPayload.put("appDesc", appDesc);
+    runningApp->setLaunchPhaseTime(LaunchPhase::LaunchPhase_SPAWNING);
+    requestPayload.put("appDesc", runningApp->getLaunchPoint()->getJson());
     requestPayload.put("appId", runningApp->getAppId());
     requestPayload.put("instanceId", runningApp->getInstanceId());
     requestPayload.put("reason", lunaTask->getReason());
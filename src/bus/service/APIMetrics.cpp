@@ -0,0 +1,113 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "APIMetrics.h"
+
+#include "base/RunningApp.h"
+
+APIMetrics::APIMetrics()
+{
+    setClassName("APIMetrics");
+}
+
+APIMetrics::~APIMetrics()
+{
+}
+
+void APIMetrics::addServiceTime(const string& kind, long long us)
+{
+    m_metrics[kind].m_serviceTime.add(us);
+}
+
+void APIMetrics::addEndToEndTime(const string& kind, long long us, bool isSuccess)
+{
+    Metric& metric = m_metrics[kind];
+    metric.m_endToEndTime.add(us);
+    if (!isSuccess)
+        metric.m_errorCount++;
+}
+
+void APIMetrics::addLaunchPhases(const RunningApp& runningApp)
+{
+    const int count = static_cast<int>(LaunchPhase::LaunchPhase_COUNT);
+    LaunchMetric& metric = m_launchMetrics[AppDescription::toString(runningApp.getLaunchPoint()->getAppDesc()->getAppType())];
+    if (metric.m_phases.empty())
+        metric.m_phases.resize(count);
+
+    long long first = 0;
+    long long prev = 0;
+    for (int i = 0; i < count; ++i) {
+        long long time = runningApp.getLaunchPhaseTime(static_cast<LaunchPhase>(i));
+        if (time == 0)
+            continue;
+        if (prev != 0)
+            metric.m_phases[i].add((time - prev) / 1000);
+        else
+            first = time;
+        prev = time;
+    }
+    if (prev != first)
+        metric.m_total.add((prev - first) / 1000);
+}
+
+void APIMetrics::toJson(JValue& json)
+{
+    if (!json.isObject())
+        return;
+
+    for (const auto& it : m_metrics) {
+        const Metric& metric = it.second;
+        JValue item = pbnjson::Object();
+
+        JValue serviceTime = pbnjson::Object();
+        metric.m_serviceTime.toJson(serviceTime);
+        item.put("serviceTime", serviceTime);
+
+        JValue endToEndTime = pbnjson::Object();
+        metric.m_endToEndTime.toJson(endToEndTime);
+        item.put("endToEndTime", endToEndTime);
+
+        long long replied = metric.m_endToEndTime.getCount();
+        item.put("errors", (int64_t) metric.m_errorCount);
+        item.put("errorRate", replied > 0 ? (double) metric.m_errorCount / replied : 0.0);
+        json.put(it.first, item);
+    }
+}
+
+void APIMetrics::toLaunchJson(JValue& json)
+{
+    if (!json.isObject())
+        return;
+
+    for (const auto& it : m_launchMetrics) {
+        const LaunchMetric& metric = it.second;
+        JValue item = pbnjson::Object();
+
+        for (size_t i = 0; i < metric.m_phases.size(); ++i) {
+            if (metric.m_phases[i].getCount() == 0)
+                continue;
+            JValue phase = pbnjson::Object();
+            metric.m_phases[i].toJson(phase);
+            item.put(RunningApp::toString(static_cast<LaunchPhase>(i)), phase);
+        }
+
+        JValue total = pbnjson::Object();
+        metric.m_total.toJson(total);
+        item.put("total", total);
+        json.put(it.first, item);
+    }
+}
@@ -0,0 +1,73 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef BUS_SERVICE_APIMETRICS_H_
+#define BUS_SERVICE_APIMETRICS_H_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <pbnjson.hpp>
+
+#include "interface/IClassName.h"
+#include "interface/ISingleton.h"
+#include "util/Histogram.h"
+
+using namespace std;
+using namespace pbnjson;
+
+class RunningApp;
+
+class APIMetrics : public ISingleton<APIMetrics>,
+                   public IClassName {
+friend class ISingleton<APIMetrics>;
+public:
+    virtual ~APIMetrics();
+
+    // Time spent in the API handler until it returns to main loop
+    void addServiceTime(const string& kind, long long us);
+    // Time from request to reply. It includes asynchronous completion.
+    void addEndToEndTime(const string& kind, long long us, bool isSuccess);
+    // Called once when the first launch of the app is completed
+    void addLaunchPhases(const RunningApp& runningApp);
+
+    void toJson(JValue& json);
+    void toLaunchJson(JValue& json);
+
+private:
+    struct Metric {
+        Metric() : m_errorCount(0) {}
+
+        Histogram m_serviceTime;
+        Histogram m_endToEndTime;
+        long long m_errorCount;
+    };
+
+    // Each phase histogram has durations from the previous reached phase
+    struct LaunchMetric {
+        vector<Histogram> m_phases;
+        Histogram m_total;
+    };
+
+    APIMetrics();
+
+    unordered_map<string, Metric> m_metrics;
+    // key is app type
+    unordered_map<string, LaunchMetric> m_launchMetrics;
+};
+
+#endif /* BUS_SERVICE_APIMETRICS_H_ */
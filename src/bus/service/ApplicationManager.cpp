@@ -18,7 +18,10 @@
 
 #include <string>
 #include <vector>
+#include <sys/wait.h>
 
+#include "base/AppDescriptionCache.h"
+#include "base/BootTimeline.h"
 #include "base/LunaTaskList.h"
 #include "base/LaunchPointList.h"
 #include "base/AppDescriptionList.h"
@@ -26,9 +29,12 @@
 #include "bus/client/AppInstallService.h"
 #include "bus/client/DB8.h"
 #include "bus/client/LSM.h"
+#include "bus/service/APIMetrics.h"
 #include "conf/SAMConf.h"
 #include "manager/PolicyManager.h"
 #include "SchemaChecker.h"
+#include "util/JsonWriter.h"
+#include "util/JValueWriter.h"
 #include "util/JValueUtil.h"
 #include "util/Time.h"
 
@@ -58,6 +64,8 @@ const char* ApplicationManager::METHOD_REMOVE_LAUNCHPOINT = "removeLaunchPoint";
 const char* ApplicationManager::METHOD_LIST_LAUNCHPOINTS = "listLaunchPoints";
 
 const char* ApplicationManager::METHOD_MANAGER_INFO = "managerInfo";
+const char* ApplicationManager::METHOD_METRICS = "metrics";
+const char* ApplicationManager::METHOD_BOOT_TIMELINE = "bootTimeline";
 
 LSMethod ApplicationManager::METHODS_ROOT[] = {
     { METHOD_LAUNCH,                   ApplicationManager::onAPICalled, LUNA_METHOD_FLAGS_NONE },
@@ -92,11 +100,14 @@ LSMethod ApplicationManager::METHODS_DEV[] = {
     { METHOD_LIST_APPS,                ApplicationManager::onAPICalled, LUNA_METHOD_FLAGS_NONE },
     { METHOD_RUNNING,                  ApplicationManager::onAPICalled, LUNA_METHOD_FLAGS_NONE },
     { METHOD_MANAGER_INFO,             ApplicationManager::onAPICalled, LUNA_METHOD_FLAGS_NONE },
+    { METHOD_METRICS,                  ApplicationManager::onAPICalled, LUNA_METHOD_FLAGS_NONE },
+    { METHOD_BOOT_TIMELINE,            ApplicationManager::onAPICalled, LUNA_METHOD_FLAGS_NONE },
     { 0,                               0,                               LUNA_METHOD_FLAGS_NONE }
 };
 
 bool ApplicationManager::onAPICalled(LSHandle* sh, LSMessage* message, void* ctx)
 {
+    long long startTimeUs = Time::getCurrentTimeUs();
     Message request(message);
     JValue requestPayload = SchemaChecker::getInstance().getRequestPayloadWithSchema(request);
     LunaApiHandler handler;
@@ -129,8 +140,12 @@ bool ApplicationManager::onAPICalled(LSHandle* sh, LSMessage* message, void* ctx
         lunaTask->setDisplayId(RuntimeInfo::getInstance().getDisplayId());
     }
 
+    if (request.isSubscription())
+        BootTimeline::getInstance().addFirst(request.getKind(), "subscription");
+
     LunaTaskList::getInstance().add(lunaTask);
     handler(std::move(lunaTask));
+    APIMetrics::getInstance().addServiceTime(request.getKind(), Time::getCurrentTimeUs() - startTimeUs);
 
 Done:
     if (!errorText.empty()) {
@@ -139,13 +154,20 @@ Done:
         responsePayload.put("errorText", errorText);
         responsePayload.put("errorCode", errorCode);
         request.respond(responsePayload.stringify().c_str());
+        APIMetrics::getInstance().addEndToEndTime(request.getKind(), Time::getCurrentTimeUs() - startTimeUs, false);
     }
     return true;
 }
 
 ApplicationManager::ApplicationManager()
     : LS::Handle(LS::registerService("com.webos.applicationManager")),
+      m_listAppsParamsClock(0),
       m_enableSubscription(false),
+      m_postingSource(0),
+      m_isRunningDirty(false),
+      m_isRunningDevDirty(false),
+      m_isForegroundAppInfoDirty(false),
+      m_isOverlayEventOnly(true),
       m_compat1("com.webos.service.applicationmanager"),
       m_compat2("com.webos.service.applicationManager")
 {
@@ -179,6 +201,8 @@ ApplicationManager::ApplicationManager()
     registerApiHandler(CATEGORY_DEV, METHOD_LIST_APPS, boost::bind(&ApplicationManager::listApps, this, boost::placeholders::_1));
     registerApiHandler(CATEGORY_DEV, METHOD_RUNNING, boost::bind(&ApplicationManager::running, this, boost::placeholders::_1));
     registerApiHandler(CATEGORY_DEV, METHOD_MANAGER_INFO, boost::bind(&ApplicationManager::managerInfo, this, boost::placeholders::_1));
+    registerApiHandler(CATEGORY_DEV, METHOD_METRICS, boost::bind(&ApplicationManager::metrics, this, boost::placeholders::_1));
+    registerApiHandler(CATEGORY_DEV, METHOD_BOOT_TIMELINE, boost::bind(&ApplicationManager::bootTimeline, this, boost::placeholders::_1));
 }
 
 ApplicationManager::~ApplicationManager()
@@ -209,6 +233,8 @@ bool ApplicationManager::attach(GMainLoop* gml)
         m_listDevAppsCompactPoint = new LS::SubscriptionPoint();        m_listDevAppsCompactPoint->setServiceHandle(this);
         m_running = new LS::SubscriptionPoint();                        m_running->setServiceHandle(this);
         m_runningDev = new LS::SubscriptionPoint();                     m_runningDev->setServiceHandle(this);
+        m_runningDelta = new LS::SubscriptionPoint();                   m_runningDelta->setServiceHandle(this);
+        m_runningDevDelta = new LS::SubscriptionPoint();                m_runningDevDelta->setServiceHandle(this);
 
         this->attachToLoop(gml);
         m_compat1.attachToLoop(gml);
@@ -222,6 +248,11 @@ void ApplicationManager::detach()
 {
     m_APIHandlers.clear();
 
+    if (m_postingSource != 0) {
+        g_source_remove(m_postingSource);
+        m_postingSource = 0;
+    }
+
     delete m_getAppLifeEvents;
     delete m_getAppLifeStatus;
     delete m_getForgroundAppInfo;
@@ -233,6 +264,8 @@ void ApplicationManager::detach()
     delete m_listDevAppsCompactPoint;
     delete m_running;
     delete m_runningDev;
+    delete m_runningDelta;
+    delete m_runningDevDelta;
 
     Handle::detach();
     m_compat1.detach();
@@ -308,15 +341,24 @@ void ApplicationManager::close(LunaTaskPtr lunaTask)
 void ApplicationManager::running(LunaTaskPtr lunaTask)
 {
     bool subscribed = false;
+    bool delta = false;
 
-    makeRunning(lunaTask->getResponsePayload(), lunaTask->isDevmodeRequest());
+    JValueUtil::getValue(lunaTask->getRequestPayload(), "delta", delta);
+    RunningState& state = lunaTask->isDevmodeRequest() ? m_runningDevState : m_runningState;
+    if (delta && state.m_isValid) {
+        // Following changes are calculated from the last posted list. So reply it instead of current one.
+        lunaTask->getResponsePayload().put("running", state.m_running.duplicate());
+    } else {
+        lunaTask->putRawResponse("running", RunningAppList::getInstance().toSerializedJson(lunaTask->isDevmodeRequest()));
+    }
+    lunaTask->getResponsePayload().put("seq", (int64_t) state.m_seq);
     lunaTask->getResponsePayload().put("returnValue", true);
 
     if (lunaTask->getRequest().isSubscription()) {
         if (lunaTask->isDevmodeRequest()) {
-            subscribed = m_runningDev->subscribe(lunaTask->getRequest());
+            subscribed = (delta ? m_runningDevDelta : m_runningDev)->subscribe(lunaTask->getRequest());
         } else {
-            subscribed = m_running->subscribe(lunaTask->getRequest());
+            subscribed = (delta ? m_runningDelta : m_running)->subscribe(lunaTask->getRequest());
         }
     }
     lunaTask->getResponsePayload().put("subscribed", subscribed);
@@ -365,7 +407,10 @@ void ApplicationManager::getForegroundAppInfo(LunaTaskPtr lunaTask)
     bool subscribed = false;
 
     JValueUtil::getValue(lunaTask->getRequestPayload(), "extraInfo", extraInfo);
-    makeGetForegroundAppInfo(lunaTask->getResponsePayload());
+    JValueWriter writer(lunaTask->getResponsePayload());
+    writer.beginObject();
+    writeForegroundAppInfo(writer, RunningAppList::getInstance().getByAppId(LSM::getInstance().getFullWindowAppId()));
+    writer.endObject();
     if (extraInfo) {
         lunaTask->getResponsePayload().put("foregroundAppInfo", LSM::getInstance().getForegroundInfo());
     }
@@ -443,20 +488,18 @@ void ApplicationManager::registerApp(LunaTaskPtr lunaTask)
 
 void ApplicationManager::listApps(LunaTaskPtr lunaTask)
 {
-    pbnjson::JValue apps = pbnjson::Array();
     pbnjson::JValue properties = pbnjson::Array();
-
-    if (JValueUtil::getValue(lunaTask->getRequestPayload(), "properties", properties) && properties.arraySize() > 0) {
-        properties.append("id");
-    }
+    JValueUtil::getValue(lunaTask->getRequestPayload(), "properties", properties);
 
     // Don't reply 'apps' in listApps during initializaion
     if (m_enableSubscription) {
-        AppDescriptionList::getInstance().toJson(apps, properties, lunaTask->isDevmodeRequest());
-        lunaTask->getResponsePayload().put("apps", apps);
+        AppDescription::Projection projection(properties, true);
+        lunaTask->putRawResponse("apps", AppDescriptionList::getInstance().toSerializedJson(projection, lunaTask->isDevmodeRequest()));
     }
 
     if (lunaTask->getRequest().isSubscription()) {
+        // parse once here. postListApps will reuse it
+        getListAppsParams(lunaTask->getRequest().getPayload());
         lunaTask->getResponsePayload().put("subscribed", LSSubscriptionAdd(this->get(), METHOD_LIST_APPS, lunaTask->getMessage(), nullptr));
     } else {
         lunaTask->getResponsePayload().put("subscribed", false);
@@ -639,9 +682,7 @@ void ApplicationManager::listLaunchPoints(LunaTaskPtr lunaTask)
 {
     // Don't reply 'apps' in listApps during initializaion
     if (m_enableSubscription) {
-        JValue launchPoints = pbnjson::Array();
-        LaunchPointList::getInstance().toJson(launchPoints);
-        lunaTask->getResponsePayload().put("launchPoints", launchPoints);
+        lunaTask->putRawResponse("launchPoints", LaunchPointList::getInstance().toSerializedJson());
     }
 
     if (lunaTask->getRequest().isSubscription())
@@ -655,14 +696,9 @@ void ApplicationManager::managerInfo(LunaTaskPtr lunaTask)
 {
     lunaTask->getResponsePayload().put("returnValue", true);
 
-    pbnjson::JValue apps = pbnjson::Array();
-    pbnjson::JValue properties = pbnjson::Array();
-    AppDescriptionList::getInstance().toJson(apps, properties);
-    lunaTask->getResponsePayload().put("apps", apps);
+    lunaTask->putRawResponse("apps", AppDescriptionList::getInstance().toSerializedJson(AppDescription::Projection()));
 
-    pbnjson::JValue launchPoints = pbnjson::Array();
-    LaunchPointList::getInstance().toJson(launchPoints);
-    lunaTask->getResponsePayload().put("launchPoints", launchPoints);
+    lunaTask->putRawResponse("launchPoints", LaunchPointList::getInstance().toSerializedJson());
 
     pbnjson::JValue running = pbnjson::Array();
     RunningAppList::getInstance().toJson(running);
@@ -672,89 +708,240 @@ void ApplicationManager::managerInfo(LunaTaskPtr lunaTask)
     LunaTaskList::getInstance().toJson(lunaTasks);
     lunaTask->getResponsePayload().put("lunaTasks", lunaTasks);
 
+    pbnjson::JValue lunaTaskStats = pbnjson::Object();
+    LunaTaskList::getInstance().toStatJson(lunaTaskStats);
+    lunaTask->getResponsePayload().put("lunaTaskStats", lunaTaskStats);
+
+    pbnjson::JValue schemaValidation = pbnjson::Object();
+    SchemaChecker::getInstance().toJson(schemaValidation);
+    lunaTask->getResponsePayload().put("schemaValidation", schemaValidation);
+
+    pbnjson::JValue appDescriptionCache = pbnjson::Object();
+    AppDescriptionCache::getInstance().toJson(appDescriptionCache);
+    lunaTask->getResponsePayload().put("appDescriptionCache", appDescriptionCache);
+
     LunaTaskList::getInstance().removeAfterReply(std::move(lunaTask));
 }
 
-void ApplicationManager::postGetAppLifeEvents(RunningApp& runningApp)
+void ApplicationManager::metrics(LunaTaskPtr lunaTask)
 {
-    if (!m_enableSubscription) return;
+    pbnjson::JValue apis = pbnjson::Object();
+    APIMetrics::getInstance().toJson(apis);
 
-    pbnjson::JValue info = pbnjson::JValue();
-    pbnjson::JValue subscriptionPayload = pbnjson::Object();
-    subscriptionPayload.put("instanceId", runningApp.getInstanceId());
-    subscriptionPayload.put("launchPointId", runningApp.getLaunchPointId());
-    subscriptionPayload.put("appId", runningApp.getAppId());
-    subscriptionPayload.put("displayId", runningApp.getDisplayId());
-    subscriptionPayload.put("returnValue", true);
-    subscriptionPayload.put("subscribed", true);
+    pbnjson::JValue launches = pbnjson::Object();
+    APIMetrics::getInstance().toLaunchJson(launches);
+
+    pbnjson::JValue running = pbnjson::Array();
+    RunningAppList::getInstance().toLaunchPhaseJson(running);
+
+    lunaTask->getResponsePayload().put("returnValue", true);
+    lunaTask->getResponsePayload().put("apis", apis);
+    lunaTask->getResponsePayload().put("launches", launches);
+    lunaTask->getResponsePayload().put("running", running);
+    LunaTaskList::getInstance().removeAfterReply(std::move(lunaTask));
+}
+
+void ApplicationManager::bootTimeline(LunaTaskPtr lunaTask)
+{
+    // The response itself can be loaded in chrome://tracing
+    string traceEvents;
+    BootTimeline::getInstance().toTraceEventsJson(traceEvents);
+    lunaTask->getResponsePayload().put("returnValue", true);
+    lunaTask->getResponsePayload().put("displayTimeUnit", "ms");
+    lunaTask->putRawResponse("traceEvents", traceEvents);
+    LunaTaskList::getInstance().removeAfterReply(std::move(lunaTask));
+}
+
+// Only native processes reaped by SAM have exit status
+template <typename Writer>
+static void writeExit(Writer& writer, const ChildExit& exit)
+{
+    if (!exit.m_hasStatus)
+        return;
+
+    if (WIFSIGNALED(exit.m_status))
+        writer.field("exitSignal", WTERMSIG(exit.m_status));
+    else
+        writer.field("exitCode", WEXITSTATUS(exit.m_status));
+
+    if (!exit.m_hasUsage)
+        return;
+    writer.key("usage").beginObject()
+          .field("userTimeMs", (long long) exit.m_usage.ru_utime.tv_sec * 1000 + exit.m_usage.ru_utime.tv_usec / 1000)
+          .field("systemTimeMs", (long long) exit.m_usage.ru_stime.tv_sec * 1000 + exit.m_usage.ru_stime.tv_usec / 1000)
+          .field("maxRssKb", (long long) exit.m_usage.ru_maxrss)
+          .endObject();
+}
+
+// Window fields of LSM foreground info
+template <typename Writer>
+static void writeWindowInfo(Writer& writer, JValue foregroundInfo)
+{
+    for (auto it : foregroundInfo.children()) {
+        const string key = it.first.asString();
+        if ("windowType" == key ||
+            "windowGroup" == key ||
+            "windowGroupOwner" == key ||
+            "windowGroupOwnerId" == key) {
+            writer.key(key.c_str()).value(it.second);
+        }
+    }
+}
+
+template <typename Writer>
+void ApplicationManager::writeAppLifeEvents(Writer& writer, RunningApp& runningApp, JValue foregroundInfo)
+{
+    writer.field("instanceId", runningApp.getInstanceId())
+          .field("launchPointId", runningApp.getLaunchPointId())
+          .field("appId", runningApp.getAppId());
+    // displayId is overwritten by foreground info
+    if (foregroundInfo.hasKey("displayId"))
+        writer.field("displayId", foregroundInfo["displayId"]);
+    else
+        writer.field("displayId", runningApp.getDisplayId());
+    writer.field("returnValue", true)
+          .field("subscribed", true);
 
     switch (runningApp.getLifeStatus()) {
     case LifeStatus::LifeStatus_PRELOADED:
-        subscriptionPayload.put("event", "preload");
-        subscriptionPayload.put("preload", runningApp.getPreload());
+        writer.field("event", "preload")
+              .field("preload", runningApp.getPreload());
         break;
 
     case LifeStatus::LifeStatus_SPLASHING:
-        subscriptionPayload.put("event", "splash");
-        subscriptionPayload.put("title", runningApp.getLaunchPoint()->getTitle());
-        subscriptionPayload.put("splashBackground", runningApp.getLaunchPoint()->getAppDesc()->getSplashBackground());
-        subscriptionPayload.put("showSplash", runningApp.isShowSplash());
-        subscriptionPayload.put("showSpinner", runningApp.isShowSpinner());
+        writer.field("event", "splash")
+              .field("title", runningApp.getLaunchPoint()->getTitle())
+              .field("splashBackground", runningApp.getLaunchPoint()->getAppDesc()->getSplashBackground())
+              .field("showSplash", runningApp.isShowSplash())
+              .field("showSpinner", runningApp.isShowSpinner());
         break;
 
     case LifeStatus::LifeStatus_LAUNCHING:
     case LifeStatus::LifeStatus_RELAUNCHING:
-        subscriptionPayload.put("event", "launch");
-        subscriptionPayload.put("reason", runningApp.getReason());
+        writer.field("event", "launch")
+              .field("reason", runningApp.getReason());
         break;
 
     case LifeStatus::LifeStatus_STOP:
-        subscriptionPayload.put("event", "stop");
-        subscriptionPayload.put("reason", runningApp.getReason());
+        writer.field("event", "stop")
+              .field("reason", runningApp.getReason());
+        writeExit(writer, runningApp.getLinuxProcess().getExit());
         break;
 
     case LifeStatus::LifeStatus_CLOSING:
-        subscriptionPayload.put("reason", runningApp.getReason());
-        subscriptionPayload.put("event", "close");
+        writer.field("reason", runningApp.getReason())
+              .field("event", "close");
         break;
 
     case LifeStatus::LifeStatus_FOREGROUND:
-        subscriptionPayload.put("event", "foreground");
-        subscriptionPayload.put("reason", runningApp.getReason());
-        LSM::getInstance().getForegroundInfoById(runningApp.getAppId(), info);
-        if (!info.isNull() && info.isObject()) {
-            for (auto it : info.children()) {
-                const string key = it.first.asString();
-                if ("windowType" == key ||
-                    "windowGroup" == key ||
-                    "windowGroupOwner" == key ||
-                    "windowGroupOwnerId" == key ||
-                    "displayId" == key) {
-                    subscriptionPayload.put(key, info[key]);
-                }
-            }
-        }
+        writer.field("event", "foreground")
+              .field("reason", runningApp.getReason());
+        writeWindowInfo(writer, foregroundInfo);
         break;
 
     case LifeStatus::LifeStatus_BACKGROUND:
-        subscriptionPayload.put("event", "background");
-        if (runningApp.isKeepAlive()) {
-            subscriptionPayload.put("status", "preload");
-        } else {
-            subscriptionPayload.put("status", "normal");
-        }
+        writer.field("event", "background")
+              .field("status", runningApp.isKeepAlive() ? "preload" : "normal");
         break;
 
     case LifeStatus::LifeStatus_PAUSED:
-        subscriptionPayload.put("event", "pause");
+        writer.field("event", "pause");
         break;
 
     default:
-        return;
+        break;
     };
+}
+
+template <typename Writer>
+void ApplicationManager::writeAppLifeStatus(Writer& writer, RunningApp& runningApp, JValue foregroundInfo)
+{
+    writer.field("returnValue", true)
+          .field("subscribed", true);
+    // displayId is overwritten by foreground info
+    runningApp.writeAPIJson(writer, false, foregroundInfo.hasKey("displayId") ? foregroundInfo["displayId"] : JValue());
+
+    switch(runningApp.getLifeStatus()) {
+    case LifeStatus::LifeStatus_FOREGROUND:
+        writeWindowInfo(writer, foregroundInfo);
+        break;
+
+    case LifeStatus::LifeStatus_BACKGROUND:
+    case LifeStatus::LifeStatus_PRELOADED:
+        writer.field("backgroundStatus", "normal");
+        break;
+
+    case LifeStatus::LifeStatus_PAUSED:
+        writer.field("backgroundStatus", "preload");
+        break;
+
+    case LifeStatus::LifeStatus_STOP:
+        writeExit(writer, runningApp.getLinuxProcess().getExit());
+        break;
+
+    default:
+        // Just send current information
+        break;
+    }
+}
+
+template <typename Writer>
+void ApplicationManager::writeForegroundAppInfo(Writer& writer, RunningAppPtr runningApp)
+{
+    if (runningApp == nullptr) {
+        writer.field("appId", "")
+              .field("instanceId", "")
+              .field("launchPointId", "");
+    } else {
+        writer.field("appId", runningApp->getAppId())
+              .field("instanceId", runningApp->getInstanceId())
+              .field("launchPointId", runningApp->getLaunchPointId())
+              .field("processId", std::to_string(runningApp->getProcessId()));
+    }
+}
+
+// Posts use JsonWriter. JValueWriter builds the same payload as JValue (e.g. benchmark)
+template void ApplicationManager::writeAppLifeEvents(JsonWriter&, RunningApp&, JValue);
+template void ApplicationManager::writeAppLifeEvents(JValueWriter&, RunningApp&, JValue);
+template void ApplicationManager::writeAppLifeStatus(JsonWriter&, RunningApp&, JValue);
+template void ApplicationManager::writeAppLifeStatus(JValueWriter&, RunningApp&, JValue);
+template void ApplicationManager::writeForegroundAppInfo(JsonWriter&, RunningAppPtr);
+template void ApplicationManager::writeForegroundAppInfo(JValueWriter&, RunningAppPtr);
+
+void ApplicationManager::postGetAppLifeEvents(RunningApp& runningApp)
+{
+    if (!m_enableSubscription) return;
+
+    switch (runningApp.getLifeStatus()) {
+    case LifeStatus::LifeStatus_PRELOADED:
+    case LifeStatus::LifeStatus_SPLASHING:
+    case LifeStatus::LifeStatus_LAUNCHING:
+    case LifeStatus::LifeStatus_RELAUNCHING:
+    case LifeStatus::LifeStatus_STOP:
+    case LifeStatus::LifeStatus_CLOSING:
+    case LifeStatus::LifeStatus_FOREGROUND:
+    case LifeStatus::LifeStatus_BACKGROUND:
+    case LifeStatus::LifeStatus_PAUSED:
+        break;
+
+    default:
+        return;
+    }
+
+    pbnjson::JValue info = pbnjson::JValue();
+    if (runningApp.getLifeStatus() == LifeStatus::LifeStatus_FOREGROUND)
+        LSM::getInstance().getForegroundInfoById(runningApp.getAppId(), info);
+    if (info.isNull() || !info.isObject())
+        info = pbnjson::Object();
+
+    m_postBuffer.clear();
+    JsonWriter writer(m_postBuffer);
+    writer.beginObject();
+    writeAppLifeEvents(writer, runningApp, info);
+    writer.endObject();
 
-    Logger::logSubscriptionPost(getClassName(), __FUNCTION__, *m_getAppLifeEvents, subscriptionPayload);
-    m_getAppLifeEvents->post(subscriptionPayload.stringify().c_str());
+    Logger::logSubscriptionPost(getClassName(), __FUNCTION__, *m_getAppLifeEvents, m_postBuffer);
+    m_getAppLifeEvents->post(m_postBuffer.c_str());
 }
 
 void ApplicationManager::postGetAppLifeStatus(RunningApp& runningApp)
@@ -762,51 +949,35 @@ void ApplicationManager::postGetAppLifeStatus(RunningApp& runningApp)
     if (!m_enableSubscription)
         return;
 
-    pbnjson::JValue subscriptionPayload = pbnjson::Object();
-    subscriptionPayload.put("returnValue", true);
-    subscriptionPayload.put("subscribed", true);
-
-    runningApp.toAPIJson(subscriptionPayload, false);
-    pbnjson::JValue foregroundInfo = pbnjson::JValue();
     switch(runningApp.getLifeStatus()) {
     case LifeStatus::LifeStatus_LAUNCHING:
     case LifeStatus::LifeStatus_RELAUNCHING:
     case LifeStatus::LifeStatus_CLOSING:
     case LifeStatus::LifeStatus_STOP:
-        // Just send current information
-        break;
-
     case LifeStatus::LifeStatus_FOREGROUND:
-        LSM::getInstance().getForegroundInfoById(runningApp.getAppId(), foregroundInfo);
-        if (!foregroundInfo.isNull() && foregroundInfo.isObject()) {
-            for (auto it : foregroundInfo.children()) {
-                const string key = it.first.asString();
-                if ("windowType" == key ||
-                    "windowGroup" == key ||
-                    "windowGroupOwner" == key ||
-                    "windowGroupOwnerId" == key ||
-                    "displayId" == key) {
-                    subscriptionPayload.put(key, foregroundInfo[key]);
-                }
-            }
-        }
-        break;
-
     case LifeStatus::LifeStatus_BACKGROUND:
     case LifeStatus::LifeStatus_PRELOADED:
-        subscriptionPayload.put("backgroundStatus", "normal");
-        break;
-
     case LifeStatus::LifeStatus_PAUSED:
-        subscriptionPayload.put("backgroundStatus", "preload");
         break;
 
     default:
         return;
     }
 
-    Logger::logSubscriptionPost(getClassName(), __FUNCTION__, *m_getAppLifeStatus, subscriptionPayload);
-    m_getAppLifeStatus->post(subscriptionPayload.stringify().c_str());
+    pbnjson::JValue foregroundInfo = pbnjson::JValue();
+    if (runningApp.getLifeStatus() == LifeStatus::LifeStatus_FOREGROUND)
+        LSM::getInstance().getForegroundInfoById(runningApp.getAppId(), foregroundInfo);
+    if (foregroundInfo.isNull() || !foregroundInfo.isObject())
+        foregroundInfo = pbnjson::Object();
+
+    m_postBuffer.clear();
+    JsonWriter writer(m_postBuffer);
+    writer.beginObject();
+    writeAppLifeStatus(writer, runningApp, foregroundInfo);
+    writer.endObject();
+
+    Logger::logSubscriptionPost(getClassName(), __FUNCTION__, *m_getAppLifeStatus, m_postBuffer);
+    m_getAppLifeStatus->post(m_postBuffer.c_str());
 }
 
 void ApplicationManager::postGetAppStatus(AppDescriptionPtr appDesc, AppStatusEvent event)
@@ -865,19 +1036,69 @@ void ApplicationManager::postGetForegroundAppInfo(bool isOverlayEvent)
 {
     if (!m_enableSubscription) return;
 
-    pbnjson::JValue subscriptionPayload;
-    subscriptionPayload = pbnjson::Object();
-    makeGetForegroundAppInfo(subscriptionPayload);
-    subscriptionPayload.put("returnValue", true);
-    subscriptionPayload.put("subscribed", true);
+    m_isForegroundAppInfoDirty = true;
+    m_isOverlayEventOnly = m_isOverlayEventOnly && isOverlayEvent;
+    schedulePosting();
+}
+
+void ApplicationManager::schedulePosting()
+{
+    if (m_postingSource != 0)
+        return;
+    // Same priority with other events. So it is flushed in the next iteration even if main loop is busy.
+    m_postingSource = g_idle_add_full(G_PRIORITY_DEFAULT, onFlushPosting, this, NULL);
+}
+
+gboolean ApplicationManager::onFlushPosting(gpointer context)
+{
+    ApplicationManager* self = static_cast<ApplicationManager*>(context);
+    self->m_postingSource = 0;
+    self->flushPosting();
+    return G_SOURCE_REMOVE;
+}
+
+void ApplicationManager::flushPosting()
+{
+    if (m_isRunningDirty) {
+        if (m_isRunningDevDirty && !RunningAppList::getInstance().isTransition(true))
+            postRunning(m_runningDevState, true);
+        if (!RunningAppList::getInstance().isTransition(false))
+            postRunning(m_runningState, false);
+        m_isRunningDirty = false;
+        m_isRunningDevDirty = false;
+    }
+
+    if (m_isForegroundAppInfoDirty) {
+        bool isOverlayEvent = m_isOverlayEventOnly;
+        m_isForegroundAppInfoDirty = false;
+        m_isOverlayEventOnly = true;
+        if (m_enableSubscription)
+            postForegroundAppInfo(isOverlayEvent);
+    }
+}
+
+void ApplicationManager::postForegroundAppInfo(bool isOverlayEvent)
+{
+    m_postBuffer.clear();
+    JsonWriter writer(m_postBuffer);
+    writer.beginObject();
+    writeForegroundAppInfo(writer, RunningAppList::getInstance().getByAppId(LSM::getInstance().getFullWindowAppId()));
+    writer.field("returnValue", true)
+          .field("subscribed", true)
+          .endObject();
 
     if (!isOverlayEvent) {
-        Logger::logSubscriptionPost(getClassName(), __FUNCTION__, *m_getForgroundAppInfo, subscriptionPayload);
-        m_getForgroundAppInfo->post(subscriptionPayload.stringify().c_str());
+        Logger::logSubscriptionPost(getClassName(), __FUNCTION__, *m_getForgroundAppInfo, m_postBuffer);
+        m_getForgroundAppInfo->post(m_postBuffer.c_str());
     }
-    subscriptionPayload.put("foregroundAppInfo", LSM::getInstance().getForegroundInfo());
-    Logger::logSubscriptionPost(getClassName(), __FUNCTION__, *m_getForgroundAppInfoExtraInfo, subscriptionPayload);
-    m_getForgroundAppInfoExtraInfo->post(subscriptionPayload.stringify().c_str());
+
+    // 'extraInfo' payload has one more field. Reopen the object and append it.
+    m_postBuffer.pop_back();
+    m_postBuffer += ",\"foregroundAppInfo\":";
+    m_postBuffer += LSM::getInstance().getForegroundInfo().stringify();
+    m_postBuffer += "}";
+    Logger::logSubscriptionPost(getClassName(), __FUNCTION__, *m_getForgroundAppInfoExtraInfo, m_postBuffer);
+    m_getForgroundAppInfoExtraInfo->post(m_postBuffer.c_str());
 }
 
 void ApplicationManager::postListApps(AppDescriptionPtr appDesc, const string& change, const string& changeReason)
@@ -893,7 +1114,17 @@ void ApplicationManager::postListApps(AppDescriptionPtr appDesc, const string& c
     if (!changeReason.empty())
         subscriptionPayload.put("changeReason", changeReason);
 
+    // Common part of all payloads. 'apps' or 'app' is appended per group
+    string header = subscriptionPayload.stringify();
+    header.pop_back();
+    header += (appDesc == nullptr) ? ",\"apps\":" : ",\"app\":";
+
     Logger::info(getClassName(), __FUNCTION__, "SubscriptionPost", change);
+    long long startTime = Time::getCurrentTimeUs();
+    int subscriberCount = 0;
+
+    // (devmode, properties) => serialized payload
+    map<string, string> groups;
     LSSubscriptionIter *iter = NULL;
     if (!LSSubscriptionAcquire(ApplicationManager::getInstance().get(), METHOD_LIST_APPS, &iter, NULL))
         return;
@@ -906,35 +1137,78 @@ void ApplicationManager::postListApps(AppDescriptionPtr appDesc, const string& c
             Logger::debug(getClassName(), __FUNCTION__, "Devmode is disabled");
             continue;
         }
-
-        pbnjson::JValue requestPayload = JDomParser::fromString(request.getPayload(), JValueUtil::getSchema("applicationManager.listApps"));
-        if (requestPayload.isNull()) {
-            Logger::warning(getClassName(), __FUNCTION__, "Failed to parse requestPayload");
+        if (appDesc != nullptr && appDesc->isDevmodeApp() != isDevmode) {
+            Logger::debug(getClassName(), __FUNCTION__, "Devmode != DevmodeApp");
             continue;
         }
 
-        JValue properties = pbnjson::Array();
-        if (JValueUtil::getValue(requestPayload, "properties", properties) && properties.isArray()) {
-            properties.append("id");
+        const ListAppsParams& params = getListAppsParams(request.getPayload());
+        if (!params.m_isValid) {
+            Logger::warning(getClassName(), __FUNCTION__, "Failed to parse requestPayload");
+            continue;
         }
 
-        if (appDesc == nullptr) {
-            pbnjson::JValue apps = pbnjson::Array();
-            AppDescriptionList::getInstance().toJson(apps, properties, isDevmode);
-            subscriptionPayload.put("apps", apps);
-        } else {
-            if (appDesc->isDevmodeApp() != isDevmode) {
-                Logger::debug(getClassName(), __FUNCTION__, "Devmode != DevmodeApp");
-                continue;
+        string groupKey = (isDevmode ? "D" : "N") + params.m_projection.getKey();
+        auto it = groups.find(groupKey);
+        if (it == groups.end()) {
+            string payload = header;
+            if (appDesc == nullptr) {
+                payload += AppDescriptionList::getInstance().toSerializedJson(params.m_projection, isDevmode);
+            } else {
+                appDesc->toProjectedJson(params.m_projection, payload);
             }
-            pbnjson::JValue app = appDesc->getJson(properties);
-            subscriptionPayload.put("app", app);
+            payload += "}";
+            it = groups.insert(make_pair(groupKey, std::move(payload))).first;
         }
         Logger::debug(getClassName(), __FUNCTION__, request.getSenderServiceName());
-        request.respond(subscriptionPayload.stringify().c_str());
+        request.respond(it->second.c_str());
+        subscriberCount++;
     }
     LSSubscriptionRelease(iter);
     iter = NULL;
+
+    Logger::debug(getClassName(), __FUNCTION__,
+                  Logger::format("subscribers(%d) groups(%d) elapsed(%lldus)", subscriberCount, (int) groups.size(), Time::getCurrentTimeUs() - startTime));
+}
+
+const ApplicationManager::ListAppsParams& ApplicationManager::getListAppsParams(const string& payload)
+{
+    auto it = m_listAppsParams.find(payload);
+    if (it != m_listAppsParams.end()) {
+        it->second.m_lastUsed = ++m_listAppsParamsClock;
+        return it->second;
+    }
+
+    // Schema can be loaded later. Don't cache the failure
+    static ListAppsParams invalidParams;
+    invalidParams.m_isValid = false;
+    JSchema schema = JSchema::AllSchema();
+    if (!JValueUtil::getSchema("applicationManager.listApps", schema))
+        return invalidParams;
+
+    // Subscribers usually send a few kinds of payloads. This is just for safety.
+    if (m_listAppsParams.size() >= MAX_LIST_APPS_PARAMS) {
+        auto oldest = m_listAppsParams.begin();
+        for (auto candidate = m_listAppsParams.begin(); candidate != m_listAppsParams.end(); ++candidate) {
+            if (candidate->second.m_lastUsed < oldest->second.m_lastUsed)
+                oldest = candidate;
+        }
+        m_listAppsParams.erase(oldest);
+    }
+
+    ListAppsParams& params = m_listAppsParams[payload];
+    params.m_isValid = false;
+    params.m_lastUsed = ++m_listAppsParamsClock;
+
+    JValue requestPayload = JDomParser::fromString(payload, schema);
+    if (requestPayload.isNull())
+        return params;
+
+    JValue properties = pbnjson::Array();
+    JValueUtil::getValue(requestPayload, "properties", properties);
+    params.m_projection = AppDescription::Projection(properties, true);
+    params.m_isValid = true;
+    return params;
 }
 
 void ApplicationManager::postListLaunchPoints(LaunchPointPtr launchPoint, string change)
@@ -945,11 +1219,8 @@ void ApplicationManager::postListLaunchPoints(LaunchPointPtr launchPoint, string
         return;
 
     pbnjson::JValue subscriptionPayload = pbnjson::Object();
-    pbnjson::JValue json = pbnjson::Object();
-
     if (launchPoint) {
-        launchPoint->toJson(json);
-        subscriptionPayload.put("launchPoint", json);
+        subscriptionPayload.put("launchPoint", launchPoint->getJson());
     } else {
         pbnjson::JValue launchPoints = pbnjson::Array();
         LaunchPointList::getInstance().toJson(launchPoints);
@@ -966,56 +1237,77 @@ void ApplicationManager::postListLaunchPoints(LaunchPointPtr launchPoint, string
 
 void ApplicationManager::postRunning(RunningAppPtr runningApp)
 {
-    static JValue prevSubscriptionPayloadAll;
-    static JValue prevSubscriptionPayloadDev;
+    if (!m_enableSubscription) return;
+
+    // runningApp might be removed before flushing. Only devmode flag is needed.
+    if (runningApp != nullptr && runningApp->getLaunchPoint()->getAppDesc()->isDevmodeApp())
+        m_isRunningDevDirty = true;
+    m_isRunningDirty = true;
+    schedulePosting();
+}
 
+void ApplicationManager::postRunning(RunningState& state, bool isDevmode)
+{
     if (!m_enableSubscription) return;
 
-    pbnjson::JValue subscriptionPayload;
-    if (runningApp != nullptr && runningApp->getLaunchPoint()->getAppDesc()->isDevmodeApp()) {
-        if (RunningAppList::getInstance().isTransition(true))
-            return;
-        subscriptionPayload = pbnjson::Object();
-        makeRunning(subscriptionPayload, true);
-        subscriptionPayload.put("subscribed", true);
-        subscriptionPayload.put("returnValue", true);
+    LS::SubscriptionPoint* point = isDevmode ? m_runningDev : m_running;
+    LS::SubscriptionPoint* deltaPoint = isDevmode ? m_runningDevDelta : m_runningDelta;
 
-        if (subscriptionPayload != prevSubscriptionPayloadDev) {
-            prevSubscriptionPayloadDev = subscriptionPayload.duplicate();
-            Logger::logSubscriptionPost(getClassName(), __FUNCTION__, *m_runningDev, subscriptionPayload);
-            m_runningDev->post(subscriptionPayload.stringify().c_str());
-        }
+    pbnjson::JValue running = pbnjson::Array();
+    RunningAppList::getInstance().toJson(running, isDevmode);
+
+    map<string, JValue> items;
+    pbnjson::JValue added = pbnjson::Array();
+    pbnjson::JValue changed = pbnjson::Array();
+    pbnjson::JValue removed = pbnjson::Array();
+    for (int i = 0; i < running.arraySize(); ++i) {
+        string instanceId = running[i]["instanceId"].asString();
+        auto it = state.m_items.find(instanceId);
+        if (it == state.m_items.end())
+            added.append(running[i]);
+        else if (it->second != running[i])
+            changed.append(running[i]);
+        items[instanceId] = running[i];
+    }
+    for (const auto& item : state.m_items) {
+        if (items.find(item.first) == items.end())
+            removed.append(item.first);
     }
 
-    if (RunningAppList::getInstance().isTransition(false))
+    bool isFull = !state.m_isValid;
+    if (!isFull && added.arraySize() == 0 && changed.arraySize() == 0 && removed.arraySize() == 0)
         return;
 
-    subscriptionPayload = pbnjson::Object();
-    makeRunning(subscriptionPayload, false);
+    state.m_seq++;
+    state.m_isValid = true;
+    state.m_running = running;
+    state.m_items.swap(items);
+
+    pbnjson::JValue subscriptionPayload = pbnjson::Object();
+    subscriptionPayload.put("running", running);
+    subscriptionPayload.put("seq", (int64_t) state.m_seq);
     subscriptionPayload.put("subscribed", true);
     subscriptionPayload.put("returnValue", true);
+    Logger::logSubscriptionPost(getClassName(), __FUNCTION__, *point, subscriptionPayload);
+    point->post(subscriptionPayload.stringify().c_str());
 
-    if (subscriptionPayload == prevSubscriptionPayloadAll) return;
-    prevSubscriptionPayloadAll = subscriptionPayload.duplicate();
-    Logger::logSubscriptionPost(getClassName(), __FUNCTION__, *m_running, subscriptionPayload);
-    m_running->post(subscriptionPayload.stringify().c_str());
-}
+    if (deltaPoint->getSubscribersCount() == 0)
+        return;
 
-void ApplicationManager::makeGetForegroundAppInfo(JValue& payload)
-{
-    string appId = LSM::getInstance().getFullWindowAppId();
-    RunningAppPtr runningApp = RunningAppList::getInstance().getByAppId(appId);
-    if (runningApp == nullptr) {
-        payload.put("appId", "");
-        payload.put("instanceId", "");
-        payload.put("launchPointId", "");
+    // Full list is sent if previous state is unknown. Client should replace whole list.
+    if (isFull) {
+        subscriptionPayload.put("full", true);
     } else {
-        payload.put("appId", runningApp->getAppId());
-        payload.put("instanceId", runningApp->getInstanceId());
-        payload.put("launchPointId", runningApp->getLaunchPointId());
-
-        payload.put("processId", std::to_string(runningApp->getProcessId()));
+        subscriptionPayload = pbnjson::Object();
+        subscriptionPayload.put("added", added);
+        subscriptionPayload.put("changed", changed);
+        subscriptionPayload.put("removed", removed);
+        subscriptionPayload.put("seq", (int64_t) state.m_seq);
+        subscriptionPayload.put("subscribed", true);
+        subscriptionPayload.put("returnValue", true);
     }
+    Logger::logSubscriptionPost(getClassName(), __FUNCTION__, *deltaPoint, subscriptionPayload);
+    deltaPoint->post(subscriptionPayload.stringify().c_str());
 }
 
 void ApplicationManager::makeRunning(JValue& payload, bool isDevmode)
@@ -73,6 +73,8 @@ public:
     static const char* METHOD_LIST_LAUNCHPOINTS;
 
     static const char* METHOD_MANAGER_INFO;
+    static const char* METHOD_METRICS;
+    static const char* METHOD_BOOT_TIMELINE;
 
     virtual ~ApplicationManager();
 
@@ -101,8 +103,12 @@ public:
     void listLaunchPoints(LunaTaskPtr lunaTask);
 
     void managerInfo(LunaTaskPtr lunaTask);
+    void metrics(LunaTaskPtr lunaTask);
+    void bootTimeline(LunaTaskPtr lunaTask);
 
     // Post
+    // 'running' and 'getForegroundAppInfo' are posted once per main loop iteration
+    // Other events are posted immediately because each event is meaningful
     void postGetAppLifeEvents(RunningApp& runningApp);
     void postGetAppLifeStatus(RunningApp& runningApp);
     void postGetAppStatus(AppDescriptionPtr appDesc, AppStatusEvent event);
@@ -112,9 +118,17 @@ public:
     void postRunning(RunningAppPtr runningApp);
 
     // make
-    void makeGetForegroundAppInfo(JValue& payload);
     void makeRunning(JValue& payload, bool isDevmode);
 
+    // Fields of fixed-shape payloads. The caller opens and closes the object.
+    // Writer is JsonWriter or JValueWriter. So posts and replies share one field list
+    template <typename Writer>
+    static void writeAppLifeEvents(Writer& writer, RunningApp& runningApp, JValue foregroundInfo);
+    template <typename Writer>
+    static void writeAppLifeStatus(Writer& writer, RunningApp& runningApp, JValue foregroundInfo);
+    template <typename Writer>
+    static void writeForegroundAppInfo(Writer& writer, RunningAppPtr runningApp);
+
     void enablePosting()
     {
         if (m_enableSubscription)
@@ -130,6 +144,9 @@ public:
     void disablePosting()
     {
         m_enableSubscription = false;
+        // Delta subscribers get full list in the next post
+        m_runningState.m_isValid = false;
+        m_runningDevState.m_isValid = false;
     }
 
 private:
@@ -143,10 +160,45 @@ private:
         m_APIHandlers[api] = std::move(handler);
     }
 
+    static const size_t MAX_LIST_APPS_PARAMS = 64;
+
+    struct ListAppsParams {
+        bool m_isValid;
+        // Subscribers with the same projection key get the same payload
+        AppDescription::Projection m_projection;
+        // The least recently used one is evicted when the cache is full
+        unsigned long long m_lastUsed;
+    };
+
+    // Last posted 'running' list. Delta subscribers get changes from this
+    struct RunningState {
+        RunningState() : m_seq(0), m_isValid(false) {}
+
+        long long m_seq;
+        bool m_isValid;
+        JValue m_running;
+        map<string, JValue> m_items;
+    };
+
+    void postRunning(RunningState& state, bool isDevmode);
+
+    static gboolean onFlushPosting(gpointer context);
+    void schedulePosting();
+    void flushPosting();
+    void postForegroundAppInfo(bool isOverlayEvent);
+
+    // Parsed listApps parameters are cached with the original payload string
+    const ListAppsParams& getListAppsParams(const string& payload);
+
     static LSMethod METHODS_ROOT[];
     static LSMethod METHODS_DEV[];
 
     map<string, LunaApiHandler> m_APIHandlers;
+    map<string, ListAppsParams> m_listAppsParams;
+    unsigned long long m_listAppsParamsClock;
+
+    // Reusable buffer for JsonWriter
+    string m_postBuffer;
 
     LS::SubscriptionPoint* m_getAppLifeEvents;
     LS::SubscriptionPoint* m_getAppLifeStatus;
@@ -159,9 +211,20 @@ private:
     LS::SubscriptionPoint* m_listDevAppsCompactPoint;
     LS::SubscriptionPoint* m_running;
     LS::SubscriptionPoint* m_runningDev;
+    LS::SubscriptionPoint* m_runningDelta;
+    LS::SubscriptionPoint* m_runningDevDelta;
+
+    RunningState m_runningState;
+    RunningState m_runningDevState;
 
     bool m_enableSubscription;
 
+    guint m_postingSource;
+    bool m_isRunningDirty;
+    bool m_isRunningDevDirty;
+    bool m_isForegroundAppInfoDirty;
+    bool m_isOverlayEventOnly;
+
     // TODO: Following should be deleted
     ApplicationManagerCompat m_compat1;
     ApplicationManagerCompat m_compat2;
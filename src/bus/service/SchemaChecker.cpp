@@ -16,11 +16,62 @@
 
 #include "SchemaChecker.h"
 
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <glib-unix.h>
+#include <sys/inotify.h>
+
 #include "ApplicationManager.h"
 #include "Environment.h"
+#include "util/JValueUtil.h"
+#include "util/Logger.h"
+#include "util/Time.h"
+
+gboolean SchemaChecker::onSchemaDirChanged(gint fd, GIOCondition condition, gpointer data)
+{
+    char buffer[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+    static const string SCHEMA_EXTENSION = ".schema";
+
+    while (true) {
+        ssize_t length = read(fd, buffer, sizeof(buffer));
+        if (length <= 0)
+            break;
+
+        for (char* ptr = buffer; ptr < buffer + length; ) {
+            const struct inotify_event* event = (const struct inotify_event*) ptr;
+            ptr += sizeof(struct inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                Logger::warning(getInstance().getClassName(), __FUNCTION__, "Event queue overflowed. Reload all schemas");
+                JValueUtil::reloadSchemas();
+                continue;
+            }
+            if (event->len == 0)
+                continue;
+
+            string name = event->name;
+            if (name.length() <= SCHEMA_EXTENSION.length() ||
+                name.compare(name.length() - SCHEMA_EXTENSION.length(), SCHEMA_EXTENSION.length(), SCHEMA_EXTENSION) != 0)
+                continue;
+
+            name.erase(name.length() - SCHEMA_EXTENSION.length());
+            // Deleted or broken schema doesn't replace the last good one
+            if (JValueUtil::reloadSchema(name))
+                Logger::info(getInstance().getClassName(), __FUNCTION__, name, "Schema is reloaded");
+            else
+                Logger::warning(getInstance().getClassName(), __FUNCTION__, name, "Failed to reload schema. Keep the last good one");
+        }
+    }
+    return G_SOURCE_CONTINUE;
+}
 
 SchemaChecker::SchemaChecker()
+    : m_inotifyFd(-1),
+      m_inotifySource(0)
 {
+    setClassName("SchemaChecker");
+
     m_APISchemaFiles[ApplicationManager::METHOD_LAUNCH] = "applicationManager.launch";
     m_APISchemaFiles[ApplicationManager::METHOD_PAUSE] = "";
     m_APISchemaFiles[ApplicationManager::METHOD_CLOSE] = "";
@@ -43,19 +94,94 @@ SchemaChecker::SchemaChecker()
 
 SchemaChecker::~SchemaChecker()
 {
+    finalize();
     m_APISchemaFiles.clear();
 }
 
+void SchemaChecker::initialize()
+{
+    loadSchemas();
+
+    if (m_inotifyFd >= 0)
+        return;
+
+    m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotifyFd < 0) {
+        Logger::warning(getClassName(), __FUNCTION__, Logger::format("Failed to init inotify: %s", strerror(errno)));
+        return;
+    }
+    // Only completely written files are reloaded
+    if (inotify_add_watch(m_inotifyFd, PATH_SAM_SCHEMAS, IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        Logger::warning(getClassName(), __FUNCTION__, Logger::format("Failed to watch %s: %s", PATH_SAM_SCHEMAS, strerror(errno)));
+        close(m_inotifyFd);
+        m_inotifyFd = -1;
+        return;
+    }
+    m_inotifySource = g_unix_fd_add(m_inotifyFd, G_IO_IN, onSchemaDirChanged, this);
+}
+
+void SchemaChecker::finalize()
+{
+    if (m_inotifySource != 0) {
+        g_source_remove(m_inotifySource);
+        m_inotifySource = 0;
+    }
+    if (m_inotifyFd >= 0) {
+        close(m_inotifyFd);
+        m_inotifyFd = -1;
+    }
+}
+
 JValue SchemaChecker::getRequestPayloadWithSchema(Message& request)
 {
     string method = request.getMethod();
     JValue requestPayload;
-    if (m_APISchemaFiles.find(method) == m_APISchemaFiles.end() || m_APISchemaFiles[method].empty()) {
+    auto it = m_APISchemaFiles.find(method);
+    if (it == m_APISchemaFiles.end() || it->second.empty()) {
         requestPayload = JDomParser::fromString(request.getPayload());
         return requestPayload;
     }
 
-    string path = PATH_SAM_SCHEMAS + m_APISchemaFiles[method] + ".schema";
-    requestPayload = JDomParser::fromString(request.getPayload(), JSchema::fromFile(path.c_str()));
+    // API payload is never accepted without its schema
+    JSchema schema = JSchema::AllSchema();
+    if (!JValueUtil::getSchema(it->second, schema)) {
+        Logger::error(getClassName(), __FUNCTION__, method, "Schema is not available. Reject the request");
+        return requestPayload;
+    }
+
+    long long start = Time::getCurrentTimeUs();
+    requestPayload = JDomParser::fromString(request.getPayload(), schema);
+    long long elapsed = Time::getCurrentTimeUs() - start;
+
+    ValidationStat& stat = m_validationStats[method];
+    stat.m_count++;
+    stat.m_totalUs += elapsed;
+    if (stat.m_maxUs < elapsed)
+        stat.m_maxUs = elapsed;
     return requestPayload;
 }
+
+void SchemaChecker::toJson(JValue& json)
+{
+    if (!json.isObject())
+        return;
+
+    for (auto it = m_validationStats.begin(); it != m_validationStats.end(); ++it) {
+        JValue stat = pbnjson::Object();
+        stat.put("count", (int64_t) it->second.m_count);
+        stat.put("totalUs", (int64_t) it->second.m_totalUs);
+        stat.put("avgUs", (int64_t) (it->second.m_totalUs / it->second.m_count));
+        stat.put("maxUs", (int64_t) it->second.m_maxUs);
+        json.put(it->first, stat);
+    }
+}
+
+void SchemaChecker::loadSchemas()
+{
+    for (auto it = m_APISchemaFiles.begin(); it != m_APISchemaFiles.end(); ++it) {
+        if (it->second.empty())
+            continue;
+        if (!JValueUtil::reloadSchema(it->second))
+            Logger::error(getClassName(), __FUNCTION__, it->second, "Failed to load schema");
+    }
+}
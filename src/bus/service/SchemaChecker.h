@@ -19,27 +19,51 @@
 
 #include <iostream>
 #include <map>
+#include <glib.h>
 #include <luna-service2/lunaservice.hpp>
 #include <pbnjson.hpp>
 
+#include "interface/IClassName.h"
 #include "interface/ISingleton.h"
 
 using namespace std;
 using namespace LS;
 using namespace pbnjson;
 
-class SchemaChecker : public ISingleton<SchemaChecker> {
+class SchemaChecker : public ISingleton<SchemaChecker>,
+                      public IClassName {
 friend class ISingleton<SchemaChecker>;
 public:
     virtual ~SchemaChecker();
 
+    void initialize();
+    void finalize();
+
     JValue getRequestPayloadWithSchema(Message& request);
     string getAPISchemaFilePath(const string& method);
 
+    void toJson(JValue& json);
+
 private:
+    static gboolean onSchemaDirChanged(gint fd, GIOCondition condition, gpointer data);
+
+    struct ValidationStat {
+        ValidationStat() : m_count(0), m_totalUs(0), m_maxUs(0) {}
+
+        long long m_count;
+        long long m_totalUs;
+        long long m_maxUs;
+    };
+
     SchemaChecker();
 
+    void loadSchemas();
+
     map<string, string> m_APISchemaFiles;
+    map<string, ValidationStat> m_validationStats;
+
+    int m_inotifyFd;
+    guint m_inotifySource;
 };
 
 #endif /* BUS_SERVICE_SCHEMACHECKER_H_ */
@@ -16,10 +16,41 @@
 
 #include "RuntimeInfo.h"
 
+#include <errno.h>
+#include <fcntl.h>
 #include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fstream>
+
+#include "util/JsonWriter.h"
+#include "util/Time.h"
+
+static const string PATH_RUNTIME_INFO_JOURNAL = string(PATH_RUNTIME_INFO) + ".journal";
+
+gboolean RuntimeInfo::onFlush(gpointer context)
+{
+    RuntimeInfo& self = getInstance();
+    self.m_flushSource = 0;
+    self.flush();
+    return G_SOURCE_REMOVE;
+}
+
+gboolean RuntimeInfo::onSync(gpointer context)
+{
+    RuntimeInfo& self = getInstance();
+    self.m_syncSource = 0;
+    self.sync();
+    return G_SOURCE_REMOVE;
+}
 
 RuntimeInfo::RuntimeInfo()
-    : m_displayId(-1),
+    : m_flushSource(0),
+      m_syncSource(0),
+      m_lastSyncTime(0),
+      m_journalFd(-1),
+      m_journalRecords(0),
+      m_displayId(-1),
       m_isInContainer(false)
 {
     setClassName("RuntimeInfo");
@@ -27,6 +58,8 @@ RuntimeInfo::RuntimeInfo()
 
 RuntimeInfo::~RuntimeInfo()
 {
+    if (m_journalFd >= 0)
+        close(m_journalFd);
 }
 
 void RuntimeInfo::initialize()
@@ -58,6 +91,20 @@ void RuntimeInfo::initialize()
     load();
 }
 
+void RuntimeInfo::finalize()
+{
+    if (m_flushSource != 0) {
+        g_source_remove(m_flushSource);
+        m_flushSource = 0;
+    }
+    flush();
+    if (m_syncSource != 0) {
+        g_source_remove(m_syncSource);
+        m_syncSource = 0;
+    }
+    sync();
+}
+
 bool RuntimeInfo::getValue(const string& key, JValue& value)
 {
     if (!m_database.hasKey(key))
@@ -70,24 +117,128 @@ bool RuntimeInfo::setValue(const string& key, JValue& value)
 {
     if (!m_database.put(key, value.duplicate()))
         return false;
-    return save();
+
+    // Only the last value of each key is written in the next main loop iteration
+    m_pendingKeys.insert(key);
+    if (m_flushSource == 0)
+        m_flushSource = g_idle_add_full(G_PRIORITY_DEFAULT, onFlush, nullptr, nullptr);
+    return true;
 }
 
 bool RuntimeInfo::save()
 {
-    if (!File::writeFile(PATH_RUNTIME_INFO, m_database.stringify("    "))) {
+    if (!File::writeFileAtomically(PATH_RUNTIME_INFO, m_database.stringify(), true)) {
         Logger::warning(getClassName(), __FUNCTION__, PATH_RUNTIME_INFO, "Failed to save RuntimeInfo");
         return false;
     }
+
+    // All records in journal are in the snapshot now. The snapshot and its rename are on storage already.
+    // If SAM crashes before truncating, replaying them again doesn't change anything.
+    if (m_journalFd >= 0) {
+        if (ftruncate(m_journalFd, 0) != 0)
+            Logger::warning(getClassName(), __FUNCTION__, Logger::format("Failed to truncate journal: %s", strerror(errno)));
+    } else {
+        unlink(PATH_RUNTIME_INFO_JOURNAL.c_str());
+    }
+    m_journalRecords = 0;
     return true;
 }
 
 bool RuntimeInfo::load()
 {
     m_database = JDomParser::fromFile(PATH_RUNTIME_INFO);
-    if (m_database.isNull()) {
+    if (m_database.isNull() || !m_database.isObject()) {
         m_database = pbnjson::Object();
-        save();
     }
+
+    int records = replayJournal();
+    if (records > 0)
+        Logger::info(getClassName(), __FUNCTION__, Logger::format("%d records are recovered from journal", records));
+
+    // Start with empty journal
+    save();
+    openJournal();
     return true;
 }
+
+int RuntimeInfo::replayJournal()
+{
+    ifstream journal(PATH_RUNTIME_INFO_JOURNAL.c_str());
+    if (!journal.is_open())
+        return 0;
+
+    int records = 0;
+    string line;
+    while (getline(journal, line)) {
+        if (line.empty())
+            continue;
+
+        // The last record can be broken if SAM or the system crashed during writing
+        JValue record = JDomParser::fromString(line);
+        string key;
+        JValue value;
+        if (!JValueUtil::getValue(record, "key", key) || !JValueUtil::getValue(record, "value", value)) {
+            Logger::warning(getClassName(), __FUNCTION__, "Broken record. Ignore remaining journal");
+            break;
+        }
+        m_database.put(key, value.duplicate());
+        records++;
+    }
+    return records;
+}
+
+void RuntimeInfo::openJournal()
+{
+    m_journalFd = open(PATH_RUNTIME_INFO_JOURNAL.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (m_journalFd < 0)
+        Logger::warning(getClassName(), __FUNCTION__, Logger::format("Failed to open journal: %s", strerror(errno)));
+}
+
+void RuntimeInfo::flush()
+{
+    if (m_pendingKeys.empty())
+        return;
+
+    if (m_journalFd < 0 || m_journalRecords + (int) m_pendingKeys.size() > COMPACTION_RECORDS) {
+        m_pendingKeys.clear();
+        save();
+        return;
+    }
+
+    string buffer;
+    for (const string& key : m_pendingKeys) {
+        JsonWriter writer(buffer);
+        writer.beginObject()
+              .field("key", key)
+              .field("value", m_database[key])
+              .endObject();
+        buffer += '\n';
+    }
+
+    // One record is one line. After partial write, following records cannot be replayed.
+    // So snapshot is saved instead and the journal is cleared.
+    if (write(m_journalFd, buffer.c_str(), buffer.size()) != (ssize_t) buffer.size()) {
+        Logger::warning(getClassName(), __FUNCTION__, "Failed to append journal. Save snapshot instead");
+        m_pendingKeys.clear();
+        save();
+        return;
+    }
+    m_journalRecords += m_pendingKeys.size();
+    m_pendingKeys.clear();
+
+    // fdatasync at most once per SYNC_INTERVAL
+    if (m_syncSource != 0)
+        return;
+    long long elapsed = Time::getCurrentTime() - m_lastSyncTime;
+    if (elapsed >= SYNC_INTERVAL)
+        sync();
+    else
+        m_syncSource = g_timeout_add(SYNC_INTERVAL - elapsed, onSync, nullptr);
+}
+
+void RuntimeInfo::sync()
+{
+    m_lastSyncTime = Time::getCurrentTime();
+    if (m_journalFd >= 0 && fdatasync(m_journalFd) != 0)
+        Logger::warning(getClassName(), __FUNCTION__, Logger::format("Failed to sync journal: %s", strerror(errno)));
+}
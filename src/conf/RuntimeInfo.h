@@ -18,7 +18,8 @@
 #define CONF_RUNTIMEINFO_H_
 
 #include <iostream>
-
+#include <set>
+#include <glib.h>
 #include <pbnjson.hpp>
 
 #include "Environment.h"
@@ -31,6 +32,9 @@
 using namespace std;
 using namespace pbnjson;
 
+// Values are persisted in write-behind way.
+// Changes in one main loop iteration are appended to the journal together.
+// The journal is merged into the snapshot file when it becomes large or SAM starts again.
 class RuntimeInfo : public ISingleton<RuntimeInfo>,
                     public IClassName {
 friend class ISingleton<RuntimeInfo> ;
@@ -38,6 +42,8 @@ public:
     virtual ~RuntimeInfo();
 
     void initialize();
+    // writes pending changes and syncs them
+    void finalize();
 
     bool getValue(const string& key, JValue& value);
     bool setValue(const string& key, JValue& value);
@@ -68,13 +74,34 @@ public:
     }
 
 private:
+    static const int COMPACTION_RECORDS = 128;
+    static const int SYNC_INTERVAL = 1000; // 1 second
+
+    static gboolean onFlush(gpointer context);
+    static gboolean onSync(gpointer context);
+
     RuntimeInfo();
 
+    // writes whole snapshot and clears journal
     bool save();
     bool load();
+    int replayJournal();
+    void openJournal();
+
+    void flush();
+    void sync();
 
     JValue m_database;
 
+    // keys which are changed after last flush
+    set<string> m_pendingKeys;
+    guint m_flushSource;
+    guint m_syncSource;
+    long long m_lastSyncTime;
+
+    int m_journalFd;
+    int m_journalRecords;
+
     int m_displayId;
     string m_deviceType;
     string m_user;
@@ -18,6 +18,21 @@
 
 #include "RuntimeInfo.h"
 
+void SAMConf::compileSet(const JValue& database, const string& key, unordered_set<string>& set)
+{
+    set.clear();
+
+    JValue array;
+    if (!JValueUtil::getValue(database, key, array) || !array.isArray())
+        return;
+
+    int size = array.arraySize();
+    for (int i = 0; i < size; ++i) {
+        if (array[i].isString())
+            set.insert(array[i].asString());
+    }
+}
+
 SAMConf::SAMConf()
     : m_isRespawned(false),
       m_isDevmodeEnabled(false),
@@ -62,6 +77,9 @@ void SAMConf::loadReadOnlyConf()
     if (m_readOnlyDatabase.isNull()) {
         Logger::warning(getClassName(), __FUNCTION__, PATH_RO_SAM_CONF, "Failed to parse read-only sam-conf");
     }
+    compileSet(m_readOnlyDatabase, "FullscreenWindowType", m_fullscreenWindowTypes);
+    compileSet(m_readOnlyDatabase, "NoJailApps", m_noJailApps);
+    compileKeepAliveApps();
 }
 
 void SAMConf::loadReadWriteConf()
@@ -80,6 +98,12 @@ void SAMConf::loadReadWriteConf()
         m_readWriteDatabase = pbnjson::Object();
         saveReadWriteConf();
     }
+    compileSet(m_readWriteDatabase, "deletedSystemApps", m_deletedSystemApps);
+    compileKeepAliveApps();
+
+    JValueUtil::getValue(m_readWriteDatabase, "language", m_language);
+    JValueUtil::getValue(m_readWriteDatabase, "script", m_script);
+    JValueUtil::getValue(m_readWriteDatabase, "region", m_region);
 }
 
 void SAMConf::saveReadWriteConf()
@@ -103,4 +127,14 @@ void SAMConf::loadBlockedList()
     if (m_blockedListDatabase.isNull()) {
         Logger::warning(getClassName(), __FUNCTION__, PATH_RO_SAM_CONF, "Failed to parse blocked-file sam-conf");
     }
+    compileSet(m_blockedListDatabase, "system.blockedAppList", m_blockedApps);
+}
+
+void SAMConf::compileKeepAliveApps()
+{
+    // keepAliveApps is union of read-only and read-write configs
+    unordered_set<string> readWriteKeepAliveApps;
+    compileSet(m_readOnlyDatabase, "keepAliveApps", m_keepAliveApps);
+    compileSet(m_readWriteDatabase, "keepAliveApps", readWriteKeepAliveApps);
+    m_keepAliveApps.insert(readWriteKeepAliveApps.begin(), readWriteKeepAliveApps.end());
 }
@@ -18,6 +18,7 @@
 #define __CONF_SAM_FONF_H__
 
 #include <string>
+#include <unordered_set>
 #include <pbnjson.hpp>
 
 #include "Environment.h"
@@ -51,6 +52,13 @@ public:
         return AppShellRunnerPath;
     }
 
+    const string& getBootTimelinePath()
+    {
+        static string BootTimelinePath = "";
+        JValueUtil::getValue(m_readOnlyDatabase, "BootTimelinePath", BootTimelinePath);
+        return BootTimelinePath;
+    }
+
     const string& getBrowserShellRunnerPath()
     {
         static string BrowserShellRunnerPath = "/usr/bin/browser-shell/run_browser_shell";
@@ -93,6 +101,42 @@ public:
         return JailModePath;
     }
 
+    int getLunaTaskTimeout()
+    {
+        static int LunaTaskTimeout = 30000;
+        JValueUtil::getValue(m_readOnlyDatabase, "LunaTaskTimeout", LunaTaskTimeout);
+        return LunaTaskTimeout;
+    }
+
+    int getScanThreadCount()
+    {
+        static int ScanThreadCount = 0;
+        JValueUtil::getValue(m_readOnlyDatabase, "ScanThreadCount", ScanThreadCount);
+        return ScanThreadCount;
+    }
+
+    int getAppWatchDelay()
+    {
+        static int AppWatchDelay = 500;
+        JValueUtil::getValue(m_readOnlyDatabase, "AppWatchDelay", AppWatchDelay);
+        return AppWatchDelay;
+    }
+
+    bool isForkServerEnabled()
+    {
+        static bool ForkServerEnabled = false;
+        JValueUtil::getValue(m_readOnlyDatabase, "ForkServerEnabled", ForkServerEnabled);
+        return ForkServerEnabled;
+    }
+
+    // Number of idle runner processes for each app type (native_qml, native_appshell, native_browsershell)
+    int getWarmRunnerCount(const string& appType)
+    {
+        int count = 0;
+        JValueUtil::getValue(m_readOnlyDatabase, "WarmRunners", appType, count);
+        return count;
+    }
+
     const string& getQmlRunnerPath()
     {
         static string QmlRunnerPath = "/usr/bin/qml-runner";
@@ -107,62 +151,21 @@ public:
         return RespawnedPath;
     }
 
-    bool isFullscreenWindowTypes(string type)
+    bool isFullscreenWindowTypes(const string& type) const
     {
-        JValue FullscreenWindowType;
-        if (!JValueUtil::getValue(m_readOnlyDatabase, "FullscreenWindowType", FullscreenWindowType) || !FullscreenWindowType.isArray()) {
-            return false;
-        }
-        int size = FullscreenWindowType.arraySize();
-        for (int i = 0; i < size; ++i) {
-            if (FullscreenWindowType[i].asString() == type) {
-                return true;
-            }
-        }
-        return false;
+        return m_fullscreenWindowTypes.count(type) > 0;
     }
 
     bool isNoJailApp(const string& appId) const
     {
-        JValue NoJailApps;
-        if (!JValueUtil::getValue(m_readOnlyDatabase, "NoJailApps", NoJailApps) || !NoJailApps.isArray()) {
-            return false;
-        }
-
-        int size = NoJailApps.arraySize();
-        for (int i = 0; i < size; ++i) {
-            if (NoJailApps[i].asString() == appId) {
-                return true;
-            }
-        }
-        return false;
+        return m_noJailApps.count(appId) > 0;
     }
 
     /** READ WRIETE CONFIGS **/
 
     bool isKeepAliveApp(const string& appId) const
     {
-        JValue keepAliveApps;
-
-        if (JValueUtil::getValue(m_readOnlyDatabase, "keepAliveApps", keepAliveApps) && keepAliveApps.isArray()) {
-            int size = keepAliveApps.arraySize();
-            for (int i = 0; i < size; ++i) {
-                if (keepAliveApps[i].asString() == appId) {
-                    return true;
-                }
-            }
-        }
-
-        if (!JValueUtil::getValue(m_readWriteDatabase, "keepAliveApps", keepAliveApps) && keepAliveApps.isArray()) {
-            int size = keepAliveApps.arraySize();
-            for (int i = 0; i < size; ++i) {
-                if (keepAliveApps[i].asString() == appId) {
-                    return true;
-                }
-            }
-        }
-
-        return false;
+        return m_keepAliveApps.count(appId) > 0;
     }
 
     void setKeepAliveApps(const JValue& array)
@@ -176,6 +179,7 @@ public:
 
         m_readWriteDatabase.put("keepAliveApps", array);
         saveReadWriteConf();
+        compileKeepAliveApps();
     }
 
     JValue getSysAssetFallbackPrecedence() const
@@ -200,18 +204,7 @@ public:
 
     bool isDeletedSystemApp(const string& appId) const
     {
-        JValue deletedSystemApps;
-        if (!JValueUtil::getValue(m_readWriteDatabase, "deletedSystemApps", deletedSystemApps) || !deletedSystemApps.isArray()) {
-            return false;
-        }
-
-        int size = deletedSystemApps.arraySize();
-        for (int i = 0; i < size; ++i) {
-            if (deletedSystemApps[i].asString() == appId) {
-                return true;
-            }
-        }
-        return false;
+        return m_deletedSystemApps.count(appId) > 0;
     }
 
     void appendDeletedSystemApp(const string& appId)
@@ -225,28 +218,23 @@ public:
             m_readWriteDatabase.put("deletedSystemApps", pbnjson::Array());
         }
         m_readWriteDatabase["deletedSystemApps"].append(appId);
+        m_deletedSystemApps.insert(appId);
         saveReadWriteConf();
     }
 
     const string& getLanguage() const
     {
-        static string language = "";
-        JValueUtil::getValue(m_readWriteDatabase, "language", language);
-        return language;
+        return m_language;
     }
 
     const string& getScript() const
     {
-        static string script = "";
-        JValueUtil::getValue(m_readWriteDatabase, "script", script);
-        return script;
+        return m_script;
     }
 
     const string& getRegion() const
     {
-        static string region = "";
-        JValueUtil::getValue(m_readWriteDatabase, "region", region);
-        return region;
+        return m_region;
     }
 
     void setLocale(const string& language, const string& script, const string& region)
@@ -256,23 +244,15 @@ public:
         m_readWriteDatabase.put("language", language);
         m_readWriteDatabase.put("script", script);
         m_readWriteDatabase.put("region", region);
+        m_language = language;
+        m_script = script;
+        m_region = region;
         saveReadWriteConf();
     }
 
     bool isBlockedApp(const string& appId) const
     {
-        JValue blockedAppList;
-        if (!JValueUtil::getValue(m_blockedListDatabase, "system.blockedAppList", blockedAppList) || !blockedAppList.isArray()) {
-            return false;
-        }
-
-        int size = blockedAppList.arraySize();
-        for (int i = 0; i < size; ++i) {
-            if (blockedAppList[i].asString() == appId) {
-                return true;
-            }
-        }
-        return false;
+        return m_blockedApps.count(appId) > 0;
     }
 
     bool isRespawned()
@@ -303,17 +283,32 @@ public:
     }
 
 private:
+    static void compileSet(const JValue& database, const string& key, unordered_set<string>& set);
+
     SAMConf();
 
     void loadReadOnlyConf();
     void loadReadWriteConf();
     void saveReadWriteConf();
     void loadBlockedList();
+    void compileKeepAliveApps();
 
     JValue m_readOnlyDatabase;
     JValue m_readWriteDatabase;
     JValue m_blockedListDatabase;
 
+    // Compiled string arrays of above databases for membership checks
+    unordered_set<string> m_fullscreenWindowTypes;
+    unordered_set<string> m_noJailApps;
+    unordered_set<string> m_keepAliveApps;
+    unordered_set<string> m_deletedSystemApps;
+    unordered_set<string> m_blockedApps;
+
+    // AppDescriptions are scanned in worker threads. So locale should be read without modification
+    string m_language;
+    string m_script;
+    string m_region;
+
     bool m_isRespawned;
     bool m_isDevmodeEnabled;
     bool m_isJailerDisabled;
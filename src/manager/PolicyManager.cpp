@@ -218,6 +218,9 @@ void PolicyManager::onRequireMemory(LunaTaskPtr lunaTask)
         return;
     }
 
+    // MemoryManager is skipped if it is not running
+    if (runningApp->getLaunchPhaseTime(LaunchPhase::LaunchPhase_MEMORY_REQUESTED) != 0)
+        runningApp->setLaunchPhaseTime(LaunchPhase::LaunchPhase_MEMORY_READY);
     runningApp->setLifeStatus(LifeStatus::LifeStatus_SPLASHED);
     AbsLifeHandler::getLifeHandler(runningApp).launch(runningApp, std::move(lunaTask));
 }
@@ -0,0 +1,244 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "util/ChildReaper.h"
+
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <glib-unix.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+
+#include "util/Logger.h"
+
+#ifndef __NR_pidfd_open
+#define __NR_pidfd_open 434
+#endif
+
+int ChildReaper::openPidfd(pid_t pid)
+{
+    return (int) syscall(__NR_pidfd_open, pid, 0);
+}
+
+gboolean ChildReaper::onReadable(gint fd, GIOCondition condition, gpointer data)
+{
+    ChildReaper& self = getInstance();
+    if (fd == self.m_epollFd)
+        self.drainPidfds();
+    else
+        self.drainSignalfd();
+    self.dispatch();
+    return G_SOURCE_CONTINUE;
+}
+
+gboolean ChildReaper::onDispatch(gpointer data)
+{
+    ChildReaper& self = getInstance();
+    self.m_dispatchSource = 0;
+    self.dispatch();
+    return G_SOURCE_REMOVE;
+}
+
+void ChildReaper::onChildWatch(GPid pid, gint status, gpointer data)
+{
+    // glib already reaped the process. Resource usage is not available
+    g_spawn_close_pid(pid);
+    getInstance().report(ChildExit(pid, status));
+}
+
+ChildReaper::ChildReaper()
+    : m_epollFd(-1),
+      m_signalFd(-1),
+      m_source(0),
+      m_dispatchSource(0),
+      m_handler(nullptr)
+{
+    setClassName("ChildReaper");
+}
+
+ChildReaper::~ChildReaper()
+{
+    stop();
+}
+
+bool ChildReaper::start()
+{
+    if (m_source != 0)
+        return true;
+
+    int pidfd = openPidfd(getpid());
+    if (pidfd >= 0) {
+        ::close(pidfd);
+        m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+        if (m_epollFd >= 0) {
+            m_source = g_unix_fd_add(m_epollFd, G_IO_IN, onReadable, this);
+            Logger::info(getClassName(), __FUNCTION__, "Children are watched with pidfd");
+            return true;
+        }
+    }
+
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGCHLD);
+    if (sigprocmask(SIG_BLOCK, &mask, NULL) == 0) {
+        m_signalFd = signalfd(-1, &mask, SFD_CLOEXEC | SFD_NONBLOCK);
+        if (m_signalFd >= 0) {
+            m_source = g_unix_fd_add(m_signalFd, G_IO_IN, onReadable, this);
+            Logger::info(getClassName(), __FUNCTION__, "pidfd is not supported. Children are watched with signalfd");
+            return true;
+        }
+        sigprocmask(SIG_UNBLOCK, &mask, NULL);
+    }
+    Logger::warning(getClassName(), __FUNCTION__, Logger::format("Failed to start: %s. Use g_child_watch_add instead", strerror(errno)));
+    return false;
+}
+
+void ChildReaper::stop()
+{
+    if (m_source != 0) {
+        g_source_remove(m_source);
+        m_source = 0;
+    }
+    if (m_dispatchSource != 0) {
+        g_source_remove(m_dispatchSource);
+        m_dispatchSource = 0;
+    }
+    for (auto& it : m_children) {
+        if (it.second >= 0)
+            ::close(it.second);
+    }
+    m_children.clear();
+    m_exits.clear();
+
+    if (m_epollFd >= 0) {
+        ::close(m_epollFd);
+        m_epollFd = -1;
+    }
+    if (m_signalFd >= 0) {
+        ::close(m_signalFd);
+        m_signalFd = -1;
+
+        sigset_t mask;
+        sigemptyset(&mask);
+        sigaddset(&mask, SIGCHLD);
+        sigprocmask(SIG_UNBLOCK, &mask, NULL);
+    }
+}
+
+void ChildReaper::watch(pid_t pid)
+{
+    if (pid <= 0)
+        return;
+
+    if (m_epollFd >= 0) {
+        // pidfd of zombie is readable. So the exit before this point is not missed
+        int pidfd = openPidfd(pid);
+        if (pidfd >= 0) {
+            struct epoll_event event;
+            event.events = EPOLLIN;
+            event.data.u64 = (uint64_t) pid;
+            if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, pidfd, &event) == 0) {
+                m_children[pid] = pidfd;
+                return;
+            }
+            ::close(pidfd);
+        }
+        Logger::warning(getClassName(), __FUNCTION__, Logger::format("Failed to watch process(%d) with pidfd: %s", pid, strerror(errno)));
+    } else if (m_signalFd >= 0) {
+        // SIGCHLD is pending in signalfd even if the process already exited
+        m_children[pid] = -1;
+        return;
+    }
+    g_child_watch_add(pid, onChildWatch, nullptr);
+}
+
+void ChildReaper::report(const ChildExit& exit)
+{
+    m_exits.push_back(exit);
+    if (m_dispatchSource == 0)
+        m_dispatchSource = g_idle_add(onDispatch, this);
+}
+
+void ChildReaper::drainPidfds()
+{
+    struct epoll_event events[MAX_EVENTS];
+    int count;
+    do {
+        count = epoll_wait(m_epollFd, events, MAX_EVENTS, 0);
+        for (int i = 0; i < count; ++i) {
+            reap((pid_t) events[i].data.u64);
+        }
+    } while (count == MAX_EVENTS || (count < 0 && errno == EINTR));
+}
+
+void ChildReaper::drainSignalfd()
+{
+    struct signalfd_siginfo info;
+    ssize_t size;
+    do {
+        size = read(m_signalFd, &info, sizeof(info));
+    } while (size == (ssize_t) sizeof(info) || (size < 0 && errno == EINTR));
+
+    // SIGCHLDs are merged while pending. All watched children should be checked
+    for (auto it = m_children.begin(); it != m_children.end();) {
+        pid_t pid = (it++)->first;
+        reap(pid);
+    }
+}
+
+bool ChildReaper::reap(pid_t pid)
+{
+    ChildExit exit(pid);
+    pid_t result;
+    do {
+        result = wait4(pid, &exit.m_status, WNOHANG, &exit.m_usage);
+    } while (result < 0 && errno == EINTR);
+
+    if (result == 0)
+        return false;
+    if (result == pid) {
+        exit.m_hasStatus = true;
+        exit.m_hasUsage = true;
+    } else {
+        Logger::warning(getClassName(), __FUNCTION__, Logger::format("Process(%d) is reaped by others: %s", pid, strerror(errno)));
+        exit.m_status = 0;
+    }
+
+    auto it = m_children.find(pid);
+    if (it != m_children.end()) {
+        // closing pidfd removes it from epoll
+        if (it->second >= 0)
+            ::close(it->second);
+        m_children.erase(it);
+    }
+    m_exits.push_back(exit);
+    return true;
+}
+
+void ChildReaper::dispatch()
+{
+    if (m_exits.empty())
+        return;
+
+    vector<ChildExit> exits;
+    exits.swap(m_exits);
+    if (m_handler)
+        m_handler(exits);
+}
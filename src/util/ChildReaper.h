@@ -0,0 +1,113 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef UTIL_CHILDREAPER_H_
+#define UTIL_CHILDREAPER_H_
+
+#include <map>
+#include <vector>
+#include <string.h>
+#include <glib.h>
+#include <sys/resource.h>
+#include <sys/types.h>
+
+#include "interface/IClassName.h"
+#include "interface/ISingleton.h"
+
+using namespace std;
+
+struct ChildExit {
+    ChildExit(pid_t pid = -1)
+        : m_pid(pid),
+          m_status(0),
+          m_hasStatus(false),
+          m_hasUsage(false)
+    {
+        memset(&m_usage, 0, sizeof(m_usage));
+    }
+
+    ChildExit(pid_t pid, int status)
+        : ChildExit(pid)
+    {
+        m_status = status;
+        m_hasStatus = true;
+    }
+
+    pid_t m_pid;
+    // wait status. It is valid only if m_hasStatus is true
+    int m_status;
+    bool m_hasStatus;
+    // Only processes which are reaped by SAM itself have resource usage
+    bool m_hasUsage;
+    struct rusage m_usage;
+};
+
+typedef void (*ChildExitFunc)(const vector<ChildExit>& exits);
+
+// Reaps all child processes of SAM with one main loop source.
+// Each child is watched with pidfd. If the kernel doesn't support pidfd, SIGCHLD is received with signalfd.
+// All exits which are ready in one wakeup are delivered to the handler at once.
+class ChildReaper : public ISingleton<ChildReaper>,
+                    public IClassName {
+friend class ISingleton<ChildReaper>;
+public:
+    virtual ~ChildReaper();
+
+    // Should be called before any thread is created in SAM. SIGCHLD is blocked in signalfd mode
+    bool start();
+    void stop();
+
+    void setHandler(ChildExitFunc handler)
+    {
+        m_handler = handler;
+    }
+
+    // The process should be a child of SAM. It is reaped by ChildReaper
+    void watch(pid_t pid);
+
+    // Exit which is observed by others (e.g. ForkServer). It is delivered with other exits
+    void report(const ChildExit& exit);
+
+    // Returns -1 if the kernel doesn't support pidfd. Works for non-child processes too
+    static int openPidfd(pid_t pid);
+
+private:
+    static const int MAX_EVENTS = 64;
+
+    static gboolean onReadable(gint fd, GIOCondition condition, gpointer data);
+    static gboolean onDispatch(gpointer data);
+    static void onChildWatch(GPid pid, gint status, gpointer data);
+
+    ChildReaper();
+
+    void drainPidfds();
+    void drainSignalfd();
+    bool reap(pid_t pid);
+    void dispatch();
+
+    int m_epollFd;
+    int m_signalFd;
+    guint m_source;
+    guint m_dispatchSource;
+    ChildExitFunc m_handler;
+
+    // pid and its pidfd. pidfd is -1 in signalfd mode
+    map<pid_t, int> m_children;
+    vector<ChildExit> m_exits;
+};
+
+#endif /* UTIL_CHILDREAPER_H_ */
@@ -16,8 +16,10 @@
 
 #include "File.h"
 
+#include <fcntl.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <stdio.h>
 #include <unistd.h>
 #include <glib.h>
 
@@ -55,6 +57,40 @@ bool File::writeFile(const string &path, const string& buffer)
     return true;
 }
 
+bool File::writeFileAtomically(const string& path, const string& buffer, bool sync)
+{
+    string tmpPath = path + ".tmp";
+    if (sync) {
+        int fd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0)
+            return false;
+        bool isWritten = (write(fd, buffer.c_str(), buffer.size()) == (ssize_t) buffer.size()) && (fdatasync(fd) == 0);
+        close(fd);
+        if (!isWritten) {
+            unlink(tmpPath.c_str());
+            return false;
+        }
+    } else if (!writeFile(tmpPath, buffer)) {
+        return false;
+    }
+    if (rename(tmpPath.c_str(), path.c_str()) != 0) {
+        unlink(tmpPath.c_str());
+        return false;
+    }
+    if (!sync)
+        return true;
+
+    // rename itself is durable only after the parent directory is flushed
+    size_t pos = path.find_last_of('/');
+    string directory = (pos == string::npos) ? "." : (pos == 0 ? "/" : path.substr(0, pos));
+    int dirFd = open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dirFd < 0)
+        return false;
+    bool isSynced = (fsync(dirFd) == 0);
+    close(dirFd);
+    return isSynced;
+}
+
 bool File::concatToFilename(const string originPath, string& returnPath, const string addingStr)
 {
     if (originPath.empty() || addingStr.empty())
@@ -101,6 +137,18 @@ bool File::isDirectory(const string& path)
     return true;
 }
 
+string File::getStamp(const string& path)
+{
+    struct stat fileStat;
+
+    if (stat(path.c_str(), &fileStat) != 0) {
+        return "";
+    }
+    return to_string((unsigned long long) fileStat.st_ino) + ":" +
+           to_string((long long) fileStat.st_mtim.tv_sec) + "." + to_string((long long) fileStat.st_mtim.tv_nsec) + ":" +
+           to_string((long long) fileStat.st_size);
+}
+
 bool File::isFile(const string& path)
 {
     struct stat fileStat;
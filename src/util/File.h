@@ -31,6 +31,9 @@ public:
     static void set_slash_to_base_path(string& path);
     static string readFile(const string& file_name);
     static bool writeFile(const string& filePath, const string& buffer);
+    // 'sync' flushes data to storage before rename and the directory after rename.
+    // Then the file is either old or new one after power loss, and it is new one once this returns true
+    static bool writeFileAtomically(const string& filePath, const string& buffer, bool sync = false);
     static bool concatToFilename(const string originPath, string& returnPath, const string addingStr);
 
     static bool isDirectory(const string& path);
@@ -39,6 +42,9 @@ public:
     static bool createFile(const string& path);
     static bool deleteFile(const string& path);
 
+    // returns "inode:mtime:size" of the file or empty string if the file doesn't exist
+    static string getStamp(const string& path);
+
     static string join(const string& a, const string& b);
 
     static void trimPath(string &path)
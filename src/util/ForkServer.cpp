@@ -0,0 +1,495 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "util/ForkServer.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <poll.h>
+#include <signal.h>
+#include <string.h>
+#include <unistd.h>
+#include <glib-unix.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+
+#include "util/ChildReaper.h"
+#include "util/Logger.h"
+
+#ifndef __NR_close_range
+#define __NR_close_range 436
+#endif
+
+// Closes all descriptors from 'firstFd' except 'keepFd'. Called in forked child
+static void closeDescriptors(int firstFd, int keepFd)
+{
+    // close_range() takes 2 syscalls regardless of RLIMIT_NOFILE
+    if ((keepFd == firstFd || syscall(__NR_close_range, firstFd, keepFd - 1, 0) == 0) &&
+        syscall(__NR_close_range, keepFd + 1, ~0U, 0) == 0)
+        return;
+
+    // Old kernel. Only opened descriptors are closed
+    DIR* dir = opendir("/proc/self/fd");
+    if (dir == NULL) {
+        long maxFd = sysconf(_SC_OPEN_MAX);
+        for (int fd = firstFd; fd < maxFd; ++fd) {
+            if (fd != keepFd)
+                close(fd);
+        }
+        return;
+    }
+
+    vector<int> fds;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (entry->d_name[0] == '.')
+            continue;
+        int fd = atoi(entry->d_name);
+        if (fd >= firstFd && fd != keepFd && fd != dirfd(dir))
+            fds.push_back(fd);
+    }
+    closedir(dir);
+    for (int fd : fds) {
+        close(fd);
+    }
+}
+
+void ForkServer::runServer(int socket)
+{
+    // Children are reaped with signalfd. SIGCHLD should be blocked before the first fork
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGCHLD);
+    sigprocmask(SIG_BLOCK, &mask, NULL);
+    int signalFd = signalfd(-1, &mask, SFD_CLOEXEC);
+
+    // Handlers of SAM are inherited. The helper should be terminated by signals
+    signal(SIGHUP, SIG_DFL);
+    signal(SIGINT, SIG_DFL);
+    signal(SIGTERM, SIG_DFL);
+    signal(SIGQUIT, SIG_DFL);
+    signal(SIGPIPE, SIG_IGN);
+
+    vector<char> buffer(MAX_MESSAGE_SIZE);
+    while (true) {
+        struct pollfd fds[2] = {
+            { socket, POLLIN, 0 },
+            { signalFd, POLLIN, 0 }
+        };
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+
+        if (fds[1].revents & POLLIN) {
+            struct signalfd_siginfo info;
+            if (read(signalFd, &info, sizeof(info)) < 0) {
+                // nothing. waitpid is called anyway
+            }
+            int status = 0;
+            pid_t pid;
+            while ((pid = waitpid(-1, &status, WNOHANG)) > 0) {
+                sendMessage(socket, MessageType_EXITED, pid, status);
+            }
+        }
+
+        if (fds[0].revents & POLLIN) {
+            char control[CMSG_SPACE(sizeof(int))];
+            struct iovec iov = { buffer.data(), buffer.size() };
+            struct msghdr msg;
+            memset(&msg, 0, sizeof(msg));
+            msg.msg_iov = &iov;
+            msg.msg_iovlen = 1;
+            msg.msg_control = control;
+            msg.msg_controllen = sizeof(control);
+
+            ssize_t size = recvmsg(socket, &msg, MSG_CMSG_CLOEXEC);
+            if (size < 0 && errno == EINTR)
+                continue;
+            if (size <= 0)
+                break;
+
+            int stdFd = -1;
+            struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+            if (cmsg && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS)
+                memcpy(&stdFd, CMSG_DATA(cmsg), sizeof(int));
+
+            handleRequest(socket, buffer.data(), size, stdFd);
+            if (stdFd >= 0)
+                close(stdFd);
+        } else if (fds[0].revents & (POLLHUP | POLLERR)) {
+            // SAM is terminated
+            break;
+        }
+    }
+    _exit(EXIT_SUCCESS);
+}
+
+void ForkServer::handleRequest(int socket, char* buffer, ssize_t size, int stdFd)
+{
+    RequestHeader header;
+    if (size < (ssize_t) sizeof(header) || buffer[size - 1] != '\0') {
+        sendMessage(socket, MessageType_FAILED, -1, EINVAL);
+        return;
+    }
+    memcpy(&header, buffer, sizeof(header));
+    if (header.m_argc < 1 || header.m_envc < 0) {
+        sendMessage(socket, MessageType_FAILED, -1, EINVAL);
+        return;
+    }
+
+    // [workingDirectory] [argv...] [envp...] separated with '\0'
+    vector<char*> strings;
+    char* end = buffer + size;
+    for (char* it = buffer + sizeof(header); it < end; it += strlen(it) + 1) {
+        strings.push_back(it);
+    }
+    if ((int) strings.size() != 1 + header.m_argc + header.m_envc) {
+        sendMessage(socket, MessageType_FAILED, -1, EINVAL);
+        return;
+    }
+    const char* workingDirectory = strings[0];
+    vector<char*> argv(strings.begin() + 1, strings.begin() + 1 + header.m_argc);
+    vector<char*> envp(strings.begin() + 1 + header.m_argc, strings.end());
+    argv.push_back(nullptr);
+    envp.push_back(nullptr);
+
+    // exec error is reported through CLOEXEC pipe. EOF means exec succeeded
+    int errorPipe[2];
+    if (pipe2(errorPipe, O_CLOEXEC) != 0) {
+        sendMessage(socket, MessageType_FAILED, -1, errno);
+        return;
+    }
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        // setpgid is needed to kill all processes which are created by application at once
+        setpgid(0, 0);
+
+        int nullFd = open("/dev/null", O_RDONLY);
+        if (nullFd >= 0)
+            dup2(nullFd, STDIN_FILENO);
+        if (stdFd >= 0) {
+            dup2(stdFd, STDOUT_FILENO);
+            dup2(stdFd, STDERR_FILENO);
+        }
+
+        // Don't leak descriptors of SAM and helper into applications
+        closeDescriptors(STDERR_FILENO + 1, errorPipe[1]);
+
+        sigset_t empty;
+        sigemptyset(&empty);
+        sigprocmask(SIG_SETMASK, &empty, NULL);
+        signal(SIGPIPE, SIG_DFL);
+
+        int error = 0;
+        if (chdir(workingDirectory) == 0)
+            execve(argv[0], argv.data(), envp.data());
+        error = errno;
+        if (write(errorPipe[1], &error, sizeof(error)) < 0) {
+            // nothing to do
+        }
+        _exit(127);
+    }
+    close(errorPipe[1]);
+
+    if (pid < 0) {
+        sendMessage(socket, MessageType_FAILED, -1, errno);
+        close(errorPipe[0]);
+        return;
+    }
+    // same with the child. Avoid race with killpg from SAM
+    setpgid(pid, pid);
+    // SAM should know the child even if exec blocks and SAM gives up waiting
+    sendMessage(socket, MessageType_FORKED, pid, 0);
+
+    int error = 0;
+    ssize_t result;
+    do {
+        result = read(errorPipe[0], &error, sizeof(error));
+    } while (result < 0 && errno == EINTR);
+    close(errorPipe[0]);
+
+    if (result == (ssize_t) sizeof(error)) {
+        waitpid(pid, NULL, 0);
+        sendMessage(socket, MessageType_FAILED, pid, error);
+        return;
+    }
+    sendMessage(socket, MessageType_SPAWNED, pid, 0);
+}
+
+void ForkServer::sendMessage(int socket, MessageType type, pid_t pid, int value)
+{
+    Message message;
+    message.m_type = type;
+    message.m_pid = pid;
+    message.m_value = value;
+    while (send(socket, &message, sizeof(message), MSG_NOSIGNAL) < 0 && errno == EINTR);
+}
+
+gboolean ForkServer::onMessage(gint fd, GIOCondition condition, gpointer data)
+{
+    ForkServer& self = getInstance();
+    if (condition & G_IO_IN) {
+        Message message;
+        if (self.receiveMessage(message, 0)) {
+            if (message.m_type == MessageType_EXITED)
+                self.handleExit(message.m_pid, message.m_value);
+            return G_SOURCE_CONTINUE;
+        }
+    }
+
+    self.m_source = 0;
+    self.handleServerDied();
+    return G_SOURCE_REMOVE;
+}
+
+gboolean ForkServer::onCheckOrphans(gpointer data)
+{
+    ForkServer& self = getInstance();
+    for (auto it = self.m_orphans.begin(); it != self.m_orphans.end();) {
+        pid_t pid = it->first;
+        int pidfd = it->second;
+        bool isExited = false;
+        if (pidfd >= 0) {
+            // pidfd is readable once the process exits. It is not confused by pid reuse
+            struct pollfd fd = { pidfd, POLLIN, 0 };
+            isExited = (poll(&fd, 1, 0) > 0);
+        } else {
+            isExited = (kill(pid, 0) == -1 && errno == ESRCH);
+        }
+
+        if (isExited) {
+            if (pidfd >= 0)
+                close(pidfd);
+            it = self.m_orphans.erase(it);
+            // Exit status is unknown because the process is reaped by init
+            ChildReaper::getInstance().report(ChildExit(pid));
+        } else {
+            ++it;
+        }
+    }
+    if (self.m_orphans.empty()) {
+        self.m_orphanSource = 0;
+        return G_SOURCE_REMOVE;
+    }
+    return G_SOURCE_CONTINUE;
+}
+
+ForkServer::ForkServer()
+    : m_pid(-1),
+      m_socket(-1),
+      m_source(0),
+      m_orphanSource(0)
+{
+    setClassName("ForkServer");
+}
+
+ForkServer::~ForkServer()
+{
+    stop();
+}
+
+bool ForkServer::start()
+{
+    if (isStarted())
+        return true;
+
+    int sockets[2];
+    if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, sockets) != 0) {
+        Logger::warning(getClassName(), __FUNCTION__, Logger::format("Failed to create socket: %s", strerror(errno)));
+        return false;
+    }
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        Logger::warning(getClassName(), __FUNCTION__, Logger::format("Failed to fork: %s", strerror(errno)));
+        close(sockets[0]);
+        close(sockets[1]);
+        return false;
+    }
+    if (pid == 0) {
+        close(sockets[0]);
+        runServer(sockets[1]);
+    }
+    close(sockets[1]);
+
+    m_pid = pid;
+    m_socket = sockets[0];
+    m_source = g_unix_fd_add(m_socket, (GIOCondition) (G_IO_IN | G_IO_HUP | G_IO_ERR), onMessage, this);
+    Logger::info(getClassName(), __FUNCTION__, Logger::format("ForkServer(%d) is started", m_pid));
+    return true;
+}
+
+void ForkServer::stop()
+{
+    if (m_source != 0) {
+        g_source_remove(m_source);
+        m_source = 0;
+    }
+    if (m_orphanSource != 0) {
+        g_source_remove(m_orphanSource);
+        m_orphanSource = 0;
+    }
+    if (m_socket >= 0) {
+        // The helper exits when the socket is closed. Running apps are not affected
+        close(m_socket);
+        m_socket = -1;
+    }
+    if (m_pid > 0) {
+        waitpid(m_pid, NULL, 0);
+        m_pid = -1;
+    }
+}
+
+bool ForkServer::spawn(const string& workingDirectory, const char* const* argv, const char* const* envp, int stdFd, pid_t& pid)
+{
+    pid = -1;
+    if (!isStarted())
+        return false;
+
+    RequestHeader header;
+    header.m_argc = 0;
+    header.m_envc = 0;
+
+    string buffer(sizeof(header), '\0');
+    buffer.append(workingDirectory.c_str(), workingDirectory.size() + 1);
+    for (; argv[header.m_argc] != nullptr; ++header.m_argc) {
+        buffer.append(argv[header.m_argc], strlen(argv[header.m_argc]) + 1);
+    }
+    for (; envp[header.m_envc] != nullptr; ++header.m_envc) {
+        buffer.append(envp[header.m_envc], strlen(envp[header.m_envc]) + 1);
+    }
+    memcpy(&buffer[0], &header, sizeof(header));
+    if (buffer.size() > MAX_MESSAGE_SIZE) {
+        Logger::warning(getClassName(), __FUNCTION__, Logger::format("Request is too large: %d bytes", (int) buffer.size()));
+        return false;
+    }
+
+    struct iovec iov = { &buffer[0], buffer.size() };
+    struct msghdr msg;
+    char control[CMSG_SPACE(sizeof(int))];
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    if (stdFd >= 0) {
+        memset(control, 0, sizeof(control));
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+        memcpy(CMSG_DATA(cmsg), &stdFd, sizeof(int));
+    }
+
+    ssize_t result;
+    do {
+        result = sendmsg(m_socket, &msg, MSG_NOSIGNAL);
+    } while (result < 0 && errno == EINTR);
+    if (result < 0) {
+        Logger::warning(getClassName(), __FUNCTION__, Logger::format("Failed to send request: %s", strerror(errno)));
+        handleServerDied();
+        return false;
+    }
+
+    pid_t forkedPid = -1;
+    Message message;
+    while (true) {
+        if (!receiveMessage(message, SPAWN_TIMEOUT)) {
+            // Don't retry with other way. The helper may have executed the app already
+            Logger::warning(getClassName(), __FUNCTION__, Logger::format("ForkServer doesn't respond. forkedPid(%d)", forkedPid));
+            pid = forkedPid;
+            handleServerDied();
+            return true;
+        }
+        if (message.m_type == MessageType_EXITED) {
+            // ChildReaper delivers it after spawn() returns
+            handleExit(message.m_pid, message.m_value);
+            continue;
+        }
+        if (message.m_type == MessageType_FORKED) {
+            forkedPid = message.m_pid;
+            m_children.insert(forkedPid);
+            continue;
+        }
+        break;
+    }
+
+    if (message.m_type == MessageType_SPAWNED) {
+        pid = message.m_pid;
+        return true;
+    }
+
+    Logger::warning(getClassName(), __FUNCTION__, Logger::format("Failed to spawn %s: %s", argv[0], strerror(message.m_value)));
+    if (forkedPid > 0) {
+        // exec failed. The helper reaped the child already
+        m_children.erase(forkedPid);
+        return true;
+    }
+    // Nothing is forked
+    return false;
+}
+
+bool ForkServer::receiveMessage(Message& message, int timeout)
+{
+    if (timeout > 0) {
+        struct pollfd fd = { m_socket, POLLIN, 0 };
+        int result;
+        do {
+            result = poll(&fd, 1, timeout);
+        } while (result < 0 && errno == EINTR);
+        if (result <= 0)
+            return false;
+    }
+
+    ssize_t size;
+    do {
+        size = recv(m_socket, &message, sizeof(message), 0);
+    } while (size < 0 && errno == EINTR);
+    return size == (ssize_t) sizeof(message);
+}
+
+void ForkServer::handleExit(pid_t pid, int status)
+{
+    m_children.erase(pid);
+    ChildReaper::getInstance().report(ChildExit(pid, status));
+}
+
+void ForkServer::handleServerDied()
+{
+    Logger::error(getClassName(), __FUNCTION__, Logger::format("ForkServer(%d) is terminated. Use g_spawn instead", m_pid));
+
+    // Apps spawned by the helper are reparented to init. Their exits are checked periodically.
+    // pidfds are opened while the helper is alive. Then the pids can't be reused before they are opened.
+    for (pid_t pid : m_children) {
+        m_orphans[pid] = ChildReaper::openPidfd(pid);
+    }
+    m_children.clear();
+
+    if (m_pid > 0)
+        kill(m_pid, SIGKILL);
+    stop();
+
+    if (!m_orphans.empty() && m_orphanSource == 0)
+        m_orphanSource = g_timeout_add(ORPHAN_CHECK_INTERVAL, onCheckOrphans, this);
+}
@@ -0,0 +1,106 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef UTIL_FORKSERVER_H_
+#define UTIL_FORKSERVER_H_
+
+#include <iostream>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+#include <glib.h>
+
+#include "interface/IClassName.h"
+#include "interface/ISingleton.h"
+
+using namespace std;
+
+// Pre-forked helper process which spawns native apps on behalf of SAM.
+// The helper is forked while SAM is still small, so fork() cost doesn't grow with SAM.
+// SAM sends spawn requests over Unix socket and the helper replies pid.
+// Because spawned apps are children of the helper, the helper reaps them and reports exit status.
+class ForkServer : public ISingleton<ForkServer>,
+                   public IClassName {
+friend class ISingleton<ForkServer>;
+public:
+    virtual ~ForkServer();
+
+    // Should be called before any thread is created in SAM.
+    bool start();
+    void stop();
+
+    bool isStarted() const
+    {
+        return m_socket >= 0;
+    }
+
+    // argv and envp should be NULL terminated.
+    // Returns false if the helper didn't take the request. Then the caller can spawn it in other way.
+    // If it returns true, the helper may have forked already. pid is -1 if the launch failed.
+    bool spawn(const string& workingDirectory, const char* const* argv, const char* const* envp, int stdFd, pid_t& pid);
+
+private:
+    static const int MAX_MESSAGE_SIZE = 64 * 1024;
+    static const int SPAWN_TIMEOUT = 3000; // 3 seconds
+    static const int ORPHAN_CHECK_INTERVAL = 1000; // 1 second
+
+    enum MessageType {
+        MessageType_FORKED, // sent before exec result. The child should be tracked from now
+        MessageType_SPAWNED,
+        MessageType_FAILED, // value is errno
+        MessageType_EXITED, // value is wait status
+    };
+
+    struct Message {
+        int32_t m_type;
+        int32_t m_pid;
+        int32_t m_value;
+    };
+
+    struct RequestHeader {
+        int32_t m_argc;
+        int32_t m_envc;
+    };
+
+    // helper process side
+    static void runServer(int socket);
+    static void handleRequest(int socket, char* buffer, ssize_t size, int stdFd);
+    static void sendMessage(int socket, MessageType type, pid_t pid, int value);
+
+    // SAM side
+    static gboolean onMessage(gint fd, GIOCondition condition, gpointer data);
+    static gboolean onCheckOrphans(gpointer data);
+
+    ForkServer();
+
+    bool receiveMessage(Message& message, int timeout);
+    void handleExit(pid_t pid, int status);
+    void handleServerDied();
+
+    pid_t m_pid;
+    int m_socket;
+    guint m_source;
+    guint m_orphanSource;
+
+    // apps spawned by the helper and not exited yet
+    set<pid_t> m_children;
+    // pid => pidfd (-1 if not supported) of apps which outlived the helper
+    map<pid_t, int> m_orphans;
+};
+
+#endif /* UTIL_FORKSERVER_H_ */
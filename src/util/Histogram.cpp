@@ -0,0 +1,79 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "Histogram.h"
+
+#include <algorithm>
+
+// upper bound (inclusive) of each bucket. The last bucket has no upper bound.
+const long long Histogram::BOUNDS[Histogram::BUCKET_COUNT - 1] = {
+    50, 100, 250, 500,
+    1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000, 500000,
+    1000000, 2500000, 5000000, 10000000, 30000000, 60000000
+};
+
+Histogram::Histogram()
+    : m_count(0),
+      m_totalUs(0),
+      m_maxUs(0)
+{
+    std::fill(m_buckets, m_buckets + BUCKET_COUNT, 0);
+}
+
+Histogram::~Histogram()
+{
+}
+
+void Histogram::add(long long us)
+{
+    if (us < 0)
+        us = 0;
+    int index = std::lower_bound(BOUNDS, BOUNDS + BUCKET_COUNT - 1, us) - BOUNDS;
+    m_buckets[index]++;
+    m_count++;
+    m_totalUs += us;
+    if (m_maxUs < us)
+        m_maxUs = us;
+}
+
+long long Histogram::getPercentile(double ratio) const
+{
+    if (m_count == 0)
+        return 0;
+
+    long long target = (long long) (ratio * m_count);
+    if (target < 1)
+        target = 1;
+
+    long long sum = 0;
+    for (int i = 0; i < BUCKET_COUNT - 1; ++i) {
+        sum += m_buckets[i];
+        if (sum >= target)
+            return std::min(BOUNDS[i], m_maxUs);
+    }
+    return m_maxUs;
+}
+
+void Histogram::toJson(JValue& json) const
+{
+    json.put("count", (int64_t) m_count);
+    json.put("avgUs", (int64_t) (m_count > 0 ? m_totalUs / m_count : 0));
+    json.put("maxUs", (int64_t) m_maxUs);
+    json.put("p50Us", (int64_t) getPercentile(0.5));
+    json.put("p90Us", (int64_t) getPercentile(0.9));
+    json.put("p99Us", (int64_t) getPercentile(0.99));
+}
@@ -0,0 +1,54 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef UTIL_HISTOGRAM_H_
+#define UTIL_HISTOGRAM_H_
+
+#include <pbnjson.hpp>
+
+using namespace pbnjson;
+
+// Fixed-bucket histogram of durations in microseconds.
+// Adding a sample is O(log(buckets)) without allocation. Percentiles are upper bounds of buckets.
+class Histogram {
+public:
+    static const int BUCKET_COUNT = 20;
+
+    Histogram();
+    virtual ~Histogram();
+
+    void add(long long us);
+
+    long long getCount() const
+    {
+        return m_count;
+    }
+    long long getPercentile(double ratio) const;
+
+    // count, avg, max, p50, p90, p99 in microseconds
+    void toJson(JValue& json) const;
+
+private:
+    static const long long BOUNDS[BUCKET_COUNT - 1];
+
+    long long m_buckets[BUCKET_COUNT];
+    long long m_count;
+    long long m_totalUs;
+    long long m_maxUs;
+};
+
+#endif /* UTIL_HISTOGRAM_H_ */
@@ -30,21 +30,50 @@ void JValueUtil::addUniqueItemToArray(pbnjson::JValue& array, string& item)
 }
 
 JSchema JValueUtil::getSchema(string name)
+{
+    // AllSchema is kept if the schema is not available
+    JSchema schema = JSchema::AllSchema();
+    getSchema(name, schema);
+    return schema;
+}
+
+bool JValueUtil::getSchema(const string& name, JSchema& schema)
 {
     if (name.empty())
-        return JSchema::AllSchema();
+        return false;
 
     auto it = s_schemas.find(name);
-    if (it != s_schemas.end())
-        return it->second;
+    if (it != s_schemas.end()) {
+        schema = it->second;
+        return true;
+    }
+
+    if (!reloadSchema(name))
+        return false;
+    schema = s_schemas.find(name)->second;
+    return true;
+}
 
+bool JValueUtil::reloadSchema(const string& name)
+{
     string path = PATH_SAM_SCHEMAS + name + ".schema";
     pbnjson::JSchema schema = JSchema::fromFile(path.c_str());
     if (!schema.isInitialized())
-        return JSchema::AllSchema();
+        return false;
 
-    s_schemas.insert(pair<string, pbnjson::JSchema>(name, schema));
-    return schema;
+    auto it = s_schemas.find(name);
+    if (it != s_schemas.end())
+        it->second = schema;
+    else
+        s_schemas.insert(pair<string, pbnjson::JSchema>(name, schema));
+    return true;
+}
+
+void JValueUtil::reloadSchemas()
+{
+    for (auto it = s_schemas.begin(); it != s_schemas.end(); ++it) {
+        reloadSchema(it->first);
+    }
 }
 
 bool JValueUtil::convertValue(const JValue& json, JValue& value)
@@ -28,6 +28,11 @@ public:
 
     static void addUniqueItemToArray(JValue& arr, string& str);
     static JSchema getSchema(string name);
+    // Unlike getSchema(name), it doesn't fall back to AllSchema. Use it for API payloads
+    static bool getSchema(const string& name, JSchema& schema);
+    // Cached schema is replaced only if the new file is compiled. Otherwise the last good one is kept
+    static bool reloadSchema(const string& name);
+    static void reloadSchemas();
 
     template <typename T>
     static bool getValue(const JValue& json, const string& key, T& value) {
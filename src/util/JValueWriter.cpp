@@ -0,0 +1,133 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "JValueWriter.h"
+
+JValueWriter::JValueWriter(JValue& root)
+    : m_root(root)
+{
+}
+
+JValueWriter::~JValueWriter()
+{
+}
+
+JValueWriter& JValueWriter::beginObject()
+{
+    if (m_stack.empty()) {
+        if (!m_root.isObject())
+            m_root = pbnjson::Object();
+        m_stack.push_back(make_pair(string(), JValue()));
+        return *this;
+    }
+    m_stack.push_back(make_pair(m_key, pbnjson::Object()));
+    return *this;
+}
+
+JValueWriter& JValueWriter::endObject()
+{
+    end();
+    return *this;
+}
+
+JValueWriter& JValueWriter::beginArray()
+{
+    if (m_stack.empty()) {
+        if (!m_root.isArray())
+            m_root = pbnjson::Array();
+        m_stack.push_back(make_pair(string(), JValue()));
+        return *this;
+    }
+    m_stack.push_back(make_pair(m_key, pbnjson::Array()));
+    return *this;
+}
+
+JValueWriter& JValueWriter::endArray()
+{
+    end();
+    return *this;
+}
+
+JValueWriter& JValueWriter::key(const char* key)
+{
+    m_key = key;
+    return *this;
+}
+
+JValueWriter& JValueWriter::value(const string& value)
+{
+    add(value);
+    return *this;
+}
+
+JValueWriter& JValueWriter::value(const char* value)
+{
+    add(value ? value : "");
+    return *this;
+}
+
+JValueWriter& JValueWriter::value(bool value)
+{
+    add(value);
+    return *this;
+}
+
+JValueWriter& JValueWriter::value(int value)
+{
+    add(value);
+    return *this;
+}
+
+JValueWriter& JValueWriter::value(long long value)
+{
+    add((int64_t) value);
+    return *this;
+}
+
+JValueWriter& JValueWriter::value(const JValue& value)
+{
+    add(value);
+    return *this;
+}
+
+void JValueWriter::add(const JValue& value)
+{
+    if (m_stack.empty())
+        return;
+
+    // The bottom of the stack is 'root' itself
+    JValue& container = (m_stack.size() == 1) ? m_root : m_stack.back().second;
+    if (container.isArray())
+        container.append(value);
+    else
+        container.put(m_key, value);
+}
+
+void JValueWriter::end()
+{
+    if (m_stack.empty())
+        return;
+
+    pair<string, JValue> child = m_stack.back();
+    m_stack.pop_back();
+    if (m_stack.empty())
+        return;
+
+    // Nested container is attached when it is completed
+    m_key = child.first;
+    add(child.second);
+}
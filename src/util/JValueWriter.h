@@ -0,0 +1,67 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef UTIL_JVALUEWRITER_H_
+#define UTIL_JVALUEWRITER_H_
+
+#include <string>
+#include <vector>
+#include <pbnjson.hpp>
+
+using namespace std;
+using namespace pbnjson;
+
+// Same interface with JsonWriter, but builds JValue with put() and append().
+// A field list which is written with a template 'Writer' parameter is shared by
+// luna replies (JValue) and subscription posts (JsonWriter). So both can't drift.
+class JValueWriter {
+public:
+    // The first beginObject() fills 'root'. Existing fields of 'root' are kept
+    JValueWriter(JValue& root);
+    virtual ~JValueWriter();
+
+    JValueWriter& beginObject();
+    JValueWriter& endObject();
+    JValueWriter& beginArray();
+    JValueWriter& endArray();
+
+    JValueWriter& key(const char* key);
+
+    JValueWriter& value(const string& value);
+    JValueWriter& value(const char* value);
+    JValueWriter& value(bool value);
+    JValueWriter& value(int value);
+    JValueWriter& value(long long value);
+    JValueWriter& value(const JValue& value);
+
+    template <typename T>
+    JValueWriter& field(const char* name, const T& v)
+    {
+        return key(name).value(v);
+    }
+
+private:
+    void add(const JValue& value);
+    void end();
+
+    JValue& m_root;
+    // (key in parent, container) of open containers. The first one stands for m_root
+    vector<pair<string, JValue>> m_stack;
+    string m_key;
+};
+
+#endif /* UTIL_JVALUEWRITER_H_ */
@@ -0,0 +1,152 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "JsonWriter.h"
+
+#include <stdio.h>
+
+void JsonWriter::escape(const string& value, string& buffer)
+{
+    buffer += '"';
+    for (const char c : value) {
+        switch (c) {
+        case '"':  buffer += "\\\""; break;
+        case '\\': buffer += "\\\\"; break;
+        case '\b': buffer += "\\b"; break;
+        case '\f': buffer += "\\f"; break;
+        case '\n': buffer += "\\n"; break;
+        case '\r': buffer += "\\r"; break;
+        case '\t': buffer += "\\t"; break;
+        default:
+            if ((unsigned char) c < 0x20) {
+                char hex[8];
+                snprintf(hex, sizeof(hex), "\\u%04x", (unsigned char) c);
+                buffer += hex;
+            } else {
+                buffer += c;
+            }
+            break;
+        }
+    }
+    buffer += '"';
+}
+
+JsonWriter::JsonWriter(string& buffer)
+    : m_buffer(buffer),
+      m_afterKey(false)
+{
+}
+
+JsonWriter::~JsonWriter()
+{
+}
+
+JsonWriter& JsonWriter::beginObject()
+{
+    separate();
+    m_buffer += '{';
+    m_isEmpty.push_back(true);
+    return *this;
+}
+
+JsonWriter& JsonWriter::endObject()
+{
+    m_buffer += '}';
+    m_isEmpty.pop_back();
+    return *this;
+}
+
+JsonWriter& JsonWriter::beginArray()
+{
+    separate();
+    m_buffer += '[';
+    m_isEmpty.push_back(true);
+    return *this;
+}
+
+JsonWriter& JsonWriter::endArray()
+{
+    m_buffer += ']';
+    m_isEmpty.pop_back();
+    return *this;
+}
+
+JsonWriter& JsonWriter::key(const char* key)
+{
+    separate();
+    m_buffer += '"';
+    m_buffer += key;
+    m_buffer += "\":";
+    m_afterKey = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(const string& value)
+{
+    separate();
+    escape(value, m_buffer);
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(const char* value)
+{
+    separate();
+    escape(value ? value : "", m_buffer);
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(bool value)
+{
+    separate();
+    m_buffer += value ? "true" : "false";
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(int value)
+{
+    separate();
+    m_buffer += std::to_string(value);
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(long long value)
+{
+    separate();
+    m_buffer += std::to_string(value);
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(const JValue& value)
+{
+    separate();
+    m_buffer += value.stringify();
+    return *this;
+}
+
+void JsonWriter::separate()
+{
+    if (m_afterKey) {
+        // value of the key. No separator
+        m_afterKey = false;
+        return;
+    }
+    if (m_isEmpty.empty())
+        return;
+    if (!m_isEmpty.back())
+        m_buffer += ',';
+    m_isEmpty.back() = false;
+}
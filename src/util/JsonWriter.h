@@ -0,0 +1,67 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef UTIL_JSONWRITER_H_
+#define UTIL_JSONWRITER_H_
+
+#include <string>
+#include <vector>
+#include <pbnjson.hpp>
+
+using namespace std;
+using namespace pbnjson;
+
+// Writes JSON directly into the given buffer without building JValue tree.
+// It is for fixed-shape payloads. Keys should be literals which don't need escaping.
+// Fields are written in calling order like JValue::put() sequence.
+class JsonWriter {
+public:
+    static void escape(const string& value, string& buffer);
+
+    JsonWriter(string& buffer);
+    virtual ~JsonWriter();
+
+    JsonWriter& beginObject();
+    JsonWriter& endObject();
+    JsonWriter& beginArray();
+    JsonWriter& endArray();
+
+    JsonWriter& key(const char* key);
+
+    JsonWriter& value(const string& value);
+    JsonWriter& value(const char* value);
+    JsonWriter& value(bool value);
+    JsonWriter& value(int value);
+    JsonWriter& value(long long value);
+    JsonWriter& value(const JValue& value);
+
+    template <typename T>
+    JsonWriter& field(const char* name, const T& v)
+    {
+        return key(name).value(v);
+    }
+
+private:
+    void separate();
+
+    string& m_buffer;
+    // true if the current container has no item yet
+    vector<bool> m_isEmpty;
+    bool m_afterKey;
+};
+
+#endif /* UTIL_JSONWRITER_H_ */
@@ -101,6 +101,14 @@ void Logger::logSubscriptionPost(const string& className, const string& function
         getInstance().write(LogLevel_INFO, className, functionName, "SubscriptionPost", key, EMPTY);
 }
 
+void Logger::logSubscriptionPost(const string& className, const string& functionName, const LS::SubscriptionPoint& point, const string& subscriptionPayload)
+{
+    if (isVerbose())
+        getInstance().write(LogLevel_INFO, className, functionName, "SubscriptionPost", Logger::format("Count=%d", point.getSubscribersCount()), subscriptionPayload);
+    else
+        getInstance().write(LogLevel_INFO, className, functionName, "SubscriptionPost", Logger::format("Count=%d", point.getSubscribersCount()), EMPTY);
+}
+
 void Logger::debug(const string& className, const string& functionName, const string& what)
 {
     getInstance().write(LogLevel_DEBUG, className, functionName, EMPTY, what, EMPTY);
@@ -57,7 +57,7 @@ public:
     template<typename ... Args>
     static const string format(const string& format, Args ... args)
     {
-        static char buffer[1024];
+        char buffer[1024];
         snprintf(buffer, 1024, format.c_str(), args ... );
         return string(buffer);
     }
@@ -88,6 +88,7 @@ public:
     static void logSubscriptionResponse(const string& className, const string& functionName, Message& response, JValue& subscriptionPayload);
     static void logSubscriptionPost(const string& className, const string& functionName, const LS::SubscriptionPoint& point, JValue& subscriptionPayload);
     static void logSubscriptionPost(const string& className, const string& functionName, const string& key, JValue& subscriptionPayload);
+    static void logSubscriptionPost(const string& className, const string& functionName, const LS::SubscriptionPoint& point, const string& subscriptionPayload);
 
     static void debug(const string& className, const string& functionName, const string& what);
     static void info(const string& className, const string& functionName, const string& what);
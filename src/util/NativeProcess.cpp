@@ -12,22 +12,18 @@
  */
 
 #include <fcntl.h>
+#include <signal.h>
 #include <errno.h>
 #include <string.h>
 #include <unistd.h>
 
 #include "util/NativeProcess.h"
+#include "util/ChildReaper.h"
+#include "util/ForkServer.h"
 #include "util/Logger.h"
 
 const string NativeProcess::CLASS_NAME = "NativeProcess";
 
-void NativeProcess::convertEnvToStr(map<string, string>& src, vector<string>& dest)
-{
-    for (auto it = src.begin(); it != src.end(); ++it) {
-        dest.push_back(it->first + "=" + it->second);
-    }
-}
-
 void NativeProcess::prepareSpawn(gpointer user_data)
 {
     // This function is called in child context.
@@ -36,6 +32,11 @@ void NativeProcess::prepareSpawn(gpointer user_data)
     if (result == -1) {
         Logger::error(CLASS_NAME, __FUNCTION__, strerror(errno));
     }
+
+    // SIGCHLD can be blocked by ChildReaper. It should not be inherited to applications
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigprocmask(SIG_SETMASK, &mask, NULL);
 }
 
 NativeProcess::NativeProcess()
@@ -43,7 +44,8 @@ NativeProcess::NativeProcess()
       m_command(""),
       m_pid(-1),
       m_stdFd(-1),
-      m_isTracked(false)
+      m_isTracked(false),
+      m_isForkServerChild(false)
 {
 
 }
@@ -64,13 +66,6 @@ void NativeProcess::addArgument(const string& option, const string& value)
     m_arguments.push_back(value);
 }
 
-void NativeProcess::addEnv(map<string, string>& environments)
-{
-    for (auto it = environments.begin(); it != environments.end(); ++it) {
-        m_environments[it->first] = it->second;
-    }
-}
-
 void NativeProcess::addEnv(const string& variable, const string& value)
 {
     m_environments[variable] = value;
@@ -87,35 +82,62 @@ void NativeProcess::closeStdFd()
 {
     if (m_stdFd >= 0)
         close(m_stdFd);
+    m_stdFd = -1;
+}
+
+void NativeProcess::buildEnvp(const BaseEnvironmentPtr& baseEnvironment, const map<string, string>& environments,
+                              vector<string>& overlay, vector<const char*>& envp)
+{
+    // Only per-process variables are serialized here. Base environment is referenced without copy
+    overlay.reserve(environments.size());
+    for (auto it = environments.begin(); it != environments.end(); ++it) {
+        overlay.push_back(it->first + "=" + it->second);
+    }
+
+    envp.reserve((baseEnvironment ? baseEnvironment->size() : 0) + overlay.size() + 1);
+    for (const string& entry : overlay) {
+        envp.push_back(entry.c_str());
+    }
+    if (baseEnvironment) {
+        for (const string& entry : *baseEnvironment) {
+            if (environments.empty() || environments.count(entry.substr(0, entry.find('='))) == 0)
+                envp.push_back(entry.c_str());
+        }
+    }
+    envp.push_back(nullptr);
 }
 
 bool NativeProcess::run()
 {
-    const char* argv[MAX_ARGS] = { 0, };
-    const char* envp[MAX_ENVP] = { 0, };
     string params = "";
-    unsigned int index = 0;
-
     GError* gerr = NULL;
-    argv[0] = m_command.c_str();
-    index = 1;
-    for (auto it = m_arguments.begin(); it != m_arguments.end() && index < MAX_ARGS; ++it) {
+
+    vector<const char*> argv;
+    argv.reserve(m_arguments.size() + 2);
+    argv.push_back(m_command.c_str());
+    for (auto it = m_arguments.begin(); it != m_arguments.end(); ++it) {
         params += *it + " ";
-        argv[index++] = it->c_str();
+        argv.push_back(it->c_str());
     }
+    argv.push_back(nullptr);
 
-    vector<string> finalEnvironments;
-    convertEnvToStr(m_environments, finalEnvironments);
-    index = 0;
-    for (auto it = finalEnvironments.begin(); it != finalEnvironments.end() && index < MAX_ENVP; ++it) {
-        envp[index++] = (const char*)it->c_str();
-    }
+    vector<string> overlay;
+    vector<const char*> envp;
+    buildEnvp(m_baseEnvironment, m_environments, overlay, envp);
 
     Logger::info(CLASS_NAME, __FUNCTION__, m_command, params);
+    if (ForkServer::getInstance().isStarted()) {
+        if (ForkServer::getInstance().spawn(m_workingDirectory, argv.data(), envp.data(), m_stdFd, m_pid)) {
+            m_isForkServerChild = (m_pid > 0);
+            return m_isForkServerChild;
+        }
+        Logger::warning(CLASS_NAME, __FUNCTION__, "Failed to spawn with ForkServer. Try g_spawn");
+    }
+
     gboolean result = g_spawn_async_with_fds(
         m_workingDirectory.c_str(),
-        const_cast<char**>(argv),
-        const_cast<char**>(envp),
+        const_cast<char**>(argv.data()),
+        const_cast<char**>(envp.data()),
         G_SPAWN_DO_NOT_REAP_CHILD,
         prepareSpawn,
         this,
@@ -135,6 +157,7 @@ bool NativeProcess::run()
         Logger::error(CLASS_NAME, __FUNCTION__, "Failed to folk child process");
         return false;
     }
+    ChildReaper::getInstance().watch(m_pid);
     return true;
 }
 
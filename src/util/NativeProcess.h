@@ -15,14 +15,19 @@
 #define UTIL_NATIVEPROCESS_H_
 
 #include <iostream>
+#include <memory>
 #include <vector>
 #include <map>
 #include <glib.h>
 
 #include "File.h"
+#include "ChildReaper.h"
 
 using namespace std;
 
+// Pre-serialized "NAME=VALUE" strings shared by all processes. It should not be changed after it is shared.
+typedef shared_ptr<const vector<string>> BaseEnvironmentPtr;
+
 class NativeProcess {
 public:
     NativeProcess();
@@ -44,8 +49,21 @@ public:
 
     void addArgument(const string& argument);
     void addArgument(const string& option, const string& value);
-    void addEnv(map<string, string>& environments);
+    const vector<string>& getArguments() const
+    {
+        return m_arguments;
+    }
+    // Base environment is passed as it is. Variables added with addEnv() override it
+    void setBaseEnv(BaseEnvironmentPtr baseEnvironment)
+    {
+        m_baseEnvironment = std::move(baseEnvironment);
+    }
     void addEnv(const string& variable, const string& value);
+    // Per-process variables only (without base environment)
+    const map<string, string>& getEnvironments() const
+    {
+        return m_environments;
+    }
 
     pid_t getPid() const
     {
@@ -78,23 +96,42 @@ public:
         return m_isTracked;
     }
 
+    // The process is a child of ForkServer. Its exit is reported by ForkServer
+    bool isForkServerChild() const
+    {
+        return m_isForkServerChild;
+    }
+
     bool isRunning()
     {
         return File::isDirectory("/proc/" + std::to_string(m_pid));
     }
 
+    // Filled when the process exits
+    const ChildExit& getExit() const
+    {
+        return m_exit;
+    }
+    void setExit(const ChildExit& exit)
+    {
+        m_exit = exit;
+    }
+
+    // Builds NULL terminated envp. 'environments' come first and override same variables in 'baseEnvironment'.
+    // Serialized 'environments' are kept in 'overlay' because envp points to them.
+    static void buildEnvp(const BaseEnvironmentPtr& baseEnvironment, const map<string, string>& environments,
+                          vector<string>& overlay, vector<const char*>& envp);
+
 private:
     static const string CLASS_NAME;
-    static const int MAX_ARGS = 16;
-    static const int MAX_ENVP = 128;
 
-    static void convertEnvToStr(map<string, string>& src, vector<string>& dest);
     static void prepareSpawn(gpointer user_data);
 
     string m_workingDirectory;
     string m_command;
 
     vector<string> m_arguments;
+    BaseEnvironmentPtr m_baseEnvironment;
     map<string, string> m_environments;
 
     pid_t m_pid;
@@ -102,6 +139,9 @@ private:
     gint m_stdFd;
 
     bool m_isTracked;
+    bool m_isForkServerChild;
+
+    ChildExit m_exit;
 
 };
 
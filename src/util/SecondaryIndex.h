@@ -0,0 +1,77 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef UTIL_SECONDARYINDEX_H_
+#define UTIL_SECONDARYINDEX_H_
+
+#include <map>
+#include <string>
+#include <unordered_map>
+
+using namespace std;
+
+// Hash index from a key to values. Several values can share one key.
+// Values with the same key are kept in id order. So find() returns same result with linear scan over id-ordered map.
+template <typename K, typename V>
+class SecondaryIndex {
+public:
+    SecondaryIndex() {}
+    virtual ~SecondaryIndex() {}
+
+    void add(const K& key, const string& id, const V& value)
+    {
+        m_index[key][id] = value;
+    }
+
+    void remove(const K& key, const string& id)
+    {
+        auto it = m_index.find(key);
+        if (it == m_index.end())
+            return;
+        it->second.erase(id);
+        if (it->second.empty())
+            m_index.erase(it);
+    }
+
+    // Returns the value with the smallest id. Default value if not found
+    V find(const K& key) const
+    {
+        auto it = m_index.find(key);
+        if (it == m_index.end() || it->second.empty())
+            return V();
+        return it->second.begin()->second;
+    }
+
+    // Returns nullptr if not found
+    const map<string, V>* findAll(const K& key) const
+    {
+        auto it = m_index.find(key);
+        if (it == m_index.end())
+            return nullptr;
+        return &it->second;
+    }
+
+    void clear()
+    {
+        m_index.clear();
+    }
+
+private:
+    unordered_map<K, map<string, V>> m_index;
+};
+
+#endif /* UTIL_SECONDARYINDEX_H_ */
@@ -37,6 +37,22 @@ long long Time::getCurrentTime()
     return (now.tv_sec * 1000) + (now.tv_nsec / 1000000);
 }
 
+long long Time::getCurrentTimeUs()
+{
+    timespec now;
+    if (clock_gettime(CLOCK_MONOTONIC, &now) == -1)
+        return -1;
+    return (now.tv_sec * 1000000LL) + (now.tv_nsec / 1000);
+}
+
+long long Time::getCurrentTimeNs()
+{
+    timespec now;
+    if (clock_gettime(CLOCK_MONOTONIC, &now) == -1)
+        return -1;
+    return (now.tv_sec * 1000000000LL) + now.tv_nsec;
+}
+
 string Time::generateUid()
 {
     boost::uuids::uuid uid = boost::uuids::random_generator()();
@@ -24,6 +24,8 @@ using namespace std;
 class Time {
 public:
     static long long getCurrentTime();
+    static long long getCurrentTimeUs();
+    static long long getCurrentTimeNs();
     static string generateUid();
 
     Time();